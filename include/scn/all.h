@@ -21,6 +21,7 @@
 #include "scn.h"
 
 #include "istream.h"
+#include "scan/parallel.h"
 #include "tuple_return.h"
 
 #endif  // SCN_ALL_H
@@ -332,6 +332,13 @@
 #define SCN_HAS_FLOAT_CHARCONV   0
 #endif
 
+// Detect __int128
+#if defined(__SIZEOF_INT128__) && !defined(SCN_DISABLE_INT128)
+#define SCN_HAS_INT128 1
+#else
+#define SCN_HAS_INT128 0
+#endif
+
 // Detect std::launder
 #if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606
 #define SCN_HAS_LAUNDER 1
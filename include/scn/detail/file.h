@@ -19,6 +19,9 @@
 #define SCN_DETAIL_FILE_H
 
 #include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
 #include <string>
 
 #include "../util/algorithm.h"
@@ -27,6 +30,34 @@
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
+    /**
+     * Hints given to the operating system on how a memory mapped file is
+     * going to be accessed. Can be combined with `|`.
+     *
+     * Hints not supported by the platform are ignored.
+     */
+    enum class map_hint : unsigned {
+        none = 0,
+        /// Pages are accessed sequentially (`MADV_SEQUENTIAL`)
+        sequential = 1,
+        /// Pages will be needed soon (`MADV_WILLNEED`)
+        willneed = 2,
+        /// Read the entire file into memory when mapping (`MAP_POPULATE`)
+        populate = 4,
+        /// Use transparent huge pages, if possible (`MADV_HUGEPAGE`)
+        huge_pages = 8
+    };
+
+    constexpr map_hint operator|(map_hint a, map_hint b) noexcept
+    {
+        return static_cast<map_hint>(static_cast<unsigned>(a) |
+                                     static_cast<unsigned>(b));
+    }
+    constexpr bool operator&(map_hint a, map_hint b) noexcept
+    {
+        return (static_cast<unsigned>(a) & static_cast<unsigned>(b)) != 0;
+    }
+
     namespace detail {
         struct native_file_handle {
 #if SCN_WINDOWS
@@ -46,21 +77,23 @@ namespace scn {
             using sentinel = const char*;
 
             byte_mapped_file() = default;
-            explicit byte_mapped_file(const char* filename);
+            explicit byte_mapped_file(const char* filename,
+                                      map_hint hints = map_hint::none);
 
             byte_mapped_file(const byte_mapped_file&) = delete;
             byte_mapped_file& operator=(const byte_mapped_file&) = delete;
 
             byte_mapped_file(byte_mapped_file&& o) noexcept
                 : m_map(exchange(o.m_map, span<char>{})),
-                  m_file(exchange(o.m_file, native_file_handle::invalid()))
+                  m_file(exchange(o.m_file, native_file_handle::invalid())),
+                  m_page_offset(exchange(o.m_page_offset, size_t{0})),
+                  m_released(exchange(o.m_released, size_t{0}))
             {
 #if SCN_WINDOWS
                 m_map_handle =
                     exchange(o.m_map_handle, native_file_handle::invalid());
 #endif
                 SCN_ENSURE(!o.valid());
-                SCN_ENSURE(valid());
             }
             byte_mapped_file& operator=(byte_mapped_file&& o) noexcept
             {
@@ -70,13 +103,14 @@ namespace scn {
 
                 m_map = exchange(o.m_map, span<char>{});
                 m_file = exchange(o.m_file, native_file_handle::invalid());
+                m_page_offset = exchange(o.m_page_offset, size_t{0});
+                m_released = exchange(o.m_released, size_t{0});
 #if SCN_WINDOWS
                 m_map_handle =
                     exchange(o.m_map_handle, native_file_handle::invalid());
 #endif
 
                 SCN_ENSURE(!o.valid());
-                SCN_ENSURE(valid());
                 return *this;
             }
 
@@ -102,10 +136,34 @@ namespace scn {
             }
 
         protected:
+            // Map `length` bytes (until EOF, if 0) of `filename`,
+            // starting from `offset`
+            error _open(const char* filename,
+                        size_t offset,
+                        size_t length,
+                        map_hint hints);
+            // Same as _open, but with an already opened handle,
+            // which is duplicated
+            error _map_handle(native_file_handle::handle_type handle,
+                              size_t offset,
+                              size_t length,
+                              map_hint hints);
+            // Takes ownership of `file`, closing it on failure
+            error _map(native_file_handle file,
+                       size_t offset,
+                       size_t length,
+                       map_hint hints);
             void _destruct();
+            void _release(size_t n) noexcept;
 
             span<char> m_map{};
             native_file_handle m_file{native_file_handle::invalid().handle};
+            // Distance from the beginning of the actual mapping to m_map,
+            // needed for mapping from offsets that aren't page-aligned
+            size_t m_page_offset{0};
+            // Number of bytes from the beginning of the mapping released
+            // with _release()
+            size_t m_released{0};
 #if SCN_WINDOWS
             native_file_handle m_map_handle{
                 native_file_handle::invalid().handle};
@@ -122,14 +180,99 @@ namespace scn {
     public:
         using iterator = const CharT*;
         using sentinel = const CharT*;
+        /// `int` file descriptor on POSIX, `HANDLE` on Windows
+        using native_handle_type = detail::native_file_handle::handle_type;
+
+        /**
+         * Map the file `filename`.
+         *
+         * Unlike the constructor, reports the reason of a failure with the
+         * returned error. On POSIX, `errno` is also left set to the cause.
+         *
+         * \code{.cpp}
+         * auto file = scn::mapped_file::open("data.txt");
+         * if (!file) {
+         *     // file.error().msg() == "No such file or directory (ENOENT)"
+         * }
+         * \endcode
+         */
+        static expected<basic_mapped_file> open(
+            const char* filename,
+            map_hint hints = map_hint::none)
+        {
+            return open(filename, 0, 0, hints);
+        }
+        /**
+         * Map `length` bytes of the file `filename`, starting from byte
+         * `offset`, which doesn't need to be aligned to the page size.
+         * If `length` is 0, or reaches past the end of the file,
+         * maps until the end of the file.
+         * If `offset` is past the end of the file, an error is returned.
+         */
+        static expected<basic_mapped_file> open(
+            const char* filename,
+            size_t offset,
+            size_t length,
+            map_hint hints = map_hint::none)
+        {
+            basic_mapped_file f{};
+            auto e = f._open(filename, offset, length, hints);
+            if (!e) {
+                return e;
+            }
+            return {SCN_MOVE(f)};
+        }
+        /**
+         * Map `length` bytes of an already opened file,
+         * starting from byte `offset`, like `open()`.
+         *
+         * The handle is duplicated: the caller keeps the ownership of
+         * `handle`, and it can be closed after this call.
+         *
+         * \code{.cpp}
+         * // map the second half of a file
+         * auto file = scn::mapped_file::map(fd, size / 2, size - size / 2);
+         * \endcode
+         */
+        static expected<basic_mapped_file> map(
+            native_handle_type handle,
+            size_t offset = 0,
+            size_t length = 0,
+            map_hint hints = map_hint::none)
+        {
+            basic_mapped_file f{};
+            auto e = f._map_handle(handle, offset, length, hints);
+            if (!e) {
+                return e;
+            }
+            return {SCN_MOVE(f)};
+        }
 
         /// Constructs an empty mapping
         basic_mapped_file() = default;
 
-        /// Constructs a mapping to a filename
+        /**
+         * Constructs a mapping to a filename.
+         * On failure, valid() is `false`.
+         *
+         * \see open
+         */
         explicit basic_mapped_file(const char* f) : detail::byte_mapped_file{f}
         {
         }
+        /**
+         * Constructs a mapping to a filename,
+         * giving `hints` to the operating system on how it's accessed.
+         *
+         * \code{.cpp}
+         * auto file = scn::mapped_file{
+         *     "data.txt", scn::map_hint::sequential | scn::map_hint::willneed};
+         * \endcode
+         */
+        basic_mapped_file(const char* f, map_hint hints)
+            : detail::byte_mapped_file{f, hints}
+        {
+        }
 
         SCN_NODISCARD iterator begin() const noexcept
         {
@@ -156,6 +299,29 @@ namespace scn {
             return {data(), size()};
         }
 
+        /**
+         * Tell the operating system that the contents of the mapping before
+         * `it` are no longer needed (`MADV_DONTNEED`), so that the pages
+         * containing them can be dropped from memory.
+         * Only whole pages are released.
+         *
+         * The mapping stays valid: released pages are read again from the
+         * file if accessed. Useful for keeping memory usage down, when
+         * scanning a large file from front to back:
+         *
+         * \code{.cpp}
+         * auto result = scn::make_result(file.wrap());
+         * while ((result = scn::scan(result.range(), "{}", i))) {
+         *     file.release(result.range().data());
+         * }
+         * \endcode
+         */
+        void release(iterator it) noexcept
+        {
+            SCN_EXPECT(it >= begin() && it <= end());
+            _release(static_cast<size_t>(it - begin()) * sizeof(CharT));
+        }
+
         detail::range_wrapper<basic_string_view<CharT>> wrap() const noexcept
         {
             return basic_string_view<CharT>{data(), size()};
@@ -170,8 +336,61 @@ namespace scn {
         struct basic_file_access;
         template <typename CharT>
         struct basic_file_iterator_access;
+
+        /**
+         * Store characters that were read from `f`, but couldn't be put
+         * back into it, to be picked up by the next `basic_file` reading
+         * from `f`. Used when a file range stops reading from `f`.
+         *
+         * Entries are keyed by the address `f`, and stay until taken, or
+         * discarded with `discard_file_handoff()`.
+         */
+        void put_file_handoff(FILE* f, std::string s);
+        void put_file_handoff(FILE* f, std::wstring s);
+        /**
+         * Take the characters stored with `put_file_handoff()` for `f`,
+         * if there are any, and append them to `s`.
+         * Doesn't allocate if `s` is empty.
+         */
+        void take_file_handoff(FILE* f, std::string& s);
+        void take_file_handoff(FILE* f, std::wstring& s);
+
+        /**
+         * Put `n` characters read from `f` back into it, so that they're
+         * read again next, by seeking backwards, or with `ungetc`.
+         * Returns the number of characters at the beginning of `s` that
+         * couldn't be put back: these need to be read before `f`.
+         */
+        size_t put_back_to_file(FILE* f, const char* s, size_t n) noexcept;
+        size_t put_back_to_file(FILE* f, const wchar_t* s, size_t n) noexcept;
     }  // namespace detail
 
+    /**
+     * Discard the characters read from `f` by a file range, that couldn't
+     * be put back into `f`, and were stored to be read by the next
+     * `basic_file` or `basic_prefetching_file` reading from `f`.
+     *
+     * These are rare, as characters are put back with `ungetc` when they
+     * can't be seeked over, but they're only left behind when
+     * a file range is destroyed, or its handle is reset.
+     * They're kept in a process-wide table, keyed by the address `f`,
+     * until they're read. Call this before closing a FILE* that has been
+     * read with a `basic_file` or a `basic_prefetching_file`, if the
+     * range was destroyed first: otherwise, a FILE* opened later at the
+     * same address could read them.
+     * `basic_owning_file::close()` does this automatically.
+     *
+     * \code{.cpp}
+     * {
+     *     auto file = scn::file{f};
+     *     // ...
+     * }
+     * scn::discard_file_handoff(f);
+     * std::fclose(f);
+     * \endcode
+     */
+    void discard_file_handoff(FILE* f) noexcept;
+
     /**
      * Range mapping to a C FILE*.
      * Not copyable or reconstructible.
@@ -214,7 +433,7 @@ namespace scn {
             iterator& operator--()
             {
                 SCN_EXPECT(m_file);
-                SCN_EXPECT(m_current > 0);
+                SCN_EXPECT(m_current > m_file->m_offset);
 
                 m_last_error = error{};
                 --m_current;
@@ -262,7 +481,18 @@ namespace scn {
 
             void reset_begin_iterator() const noexcept
             {
-                m_current = 0;
+                // Positions are absolute: the beginning of the range is
+                // not necessarily 0 with a window
+                if (m_file) {
+                    m_current = m_file->begin().m_current;
+                }
+            }
+
+            void set_rollback_point() const noexcept
+            {
+                if (m_file) {
+                    m_file->m_rollback = m_current;
+                }
             }
 
         private:
@@ -290,23 +520,46 @@ namespace scn {
          * Construct from a FILE*.
          * Must be a valid handle that can be read from.
          */
-        basic_file(FILE* f) : m_file{f} {}
+        basic_file(FILE* f) : m_file{f}
+        {
+            _take_handoff();
+        }
+        /**
+         * Construct from a FILE*, reading `block_size` characters at a time.
+         *
+         * \see set_block_size
+         */
+        basic_file(FILE* f, size_t block_size)
+            : m_file{f}, m_block_size{block_size}
+        {
+            SCN_EXPECT(block_size > 0);
+            _take_handoff();
+        }
 
         basic_file(const basic_file&) = delete;
         basic_file& operator=(const basic_file&) = delete;
 
         basic_file(basic_file&& o) noexcept
             : m_buffer(detail::exchange(o.m_buffer, {})),
-              m_file(detail::exchange(o.m_file, nullptr))
+              m_file(detail::exchange(o.m_file, nullptr)),
+              m_block_size(detail::exchange(o.m_block_size, size_t{1})),
+              m_window_size(detail::exchange(o.m_window_size, size_t{0})),
+              m_offset(detail::exchange(o.m_offset, size_t{0})),
+              m_rollback(detail::exchange(o.m_rollback, size_t{0}))
         {
         }
         basic_file& operator=(basic_file&& o) noexcept
         {
             if (valid()) {
-                sync();
+                _sync_all();
+                _hand_off();
             }
             m_buffer = detail::exchange(o.m_buffer, {});
             m_file = detail::exchange(o.m_file, nullptr);
+            m_block_size = detail::exchange(o.m_block_size, size_t{1});
+            m_window_size = detail::exchange(o.m_window_size, size_t{0});
+            m_offset = detail::exchange(o.m_offset, size_t{0});
+            m_rollback = detail::exchange(o.m_rollback, size_t{0});
             return *this;
         }
 
@@ -314,6 +567,7 @@ namespace scn {
         {
             if (valid()) {
                 _sync_all();
+                _hand_off();
             }
         }
 
@@ -332,15 +586,20 @@ namespace scn {
         /**
          * Reset the file handle.
          * Calls sync(), if necessary, before resetting.
+         * Without `allow_sync`, the characters read from the old handle,
+         * but not consumed, are discarded.
          * @return The old handle
          */
         FILE* set_handle(FILE* f, bool allow_sync = true) noexcept
         {
             auto old = m_file;
             if (old && allow_sync) {
-                sync();
+                _sync_all();
+                _hand_off();
             }
+            _clear_buffer();
             m_file = f;
+            _take_handoff();
             return old;
         }
 
@@ -350,6 +609,64 @@ namespace scn {
             return m_file != nullptr;
         }
 
+        /// Number of characters read from the FILE* at a time
+        SCN_NODISCARD size_t block_size() const noexcept
+        {
+            return m_block_size;
+        }
+        /**
+         * Set the number of characters read from the FILE* at a time.
+         *
+         * By default, characters are read one by one with `fgetc` (or
+         * `fgetwc`), which never blocks waiting for more input than is needed
+         * by the scanning operation, making it suitable for interactive input.
+         *
+         * With a larger block size, the FILE* is read in blocks of `n`
+         * characters with `fread` (or `fgetwc` in a loop), which are then
+         * made available all at once with get_buffer(). This makes scanning
+         * considerably faster, but a read blocks until either `n` characters
+         * have been read, or EOF has been reached.
+         */
+        void set_block_size(size_t n) noexcept
+        {
+            SCN_EXPECT(n > 0);
+            m_block_size = n;
+        }
+
+        /// Maximum size of the internal buffer, or 0 if unbounded
+        SCN_NODISCARD size_t window_size() const noexcept
+        {
+            return m_window_size;
+        }
+        /**
+         * Bound the internal buffer of this file to approximately `n`
+         * characters. With `n == 0` (the default), the buffer is unbounded,
+         * and every character read is kept until sync() is called.
+         *
+         * With a window set, the file works like a stream:
+         * the characters consumed by a successful scanning operation are
+         * discarded when the buffer is refilled, and begin() points to the
+         * first character not yet consumed, so that sync() doesn't need to
+         * be called between scanning operations.
+         * The characters between the last rollback point and the end of
+         * the buffer are never discarded, so a single scanning operation can
+         * still make the buffer grow larger than `n`.
+         *
+         * Iterators pointing to discarded characters are invalidated.
+         *
+         * \code{.cpp}
+         * auto file = scn::file{stdin};
+         * file.set_window_size(64 * 1024);
+         * while (scn::scan(file, "{}", i)) {
+         *     // ...
+         * }
+         * \endcode
+         */
+        void set_window_size(size_t n) noexcept
+        {
+            m_window_size = n;
+        }
+
         /**
          * Synchronizes this file with the underlying FILE*.
          * Invalidates all non-end iterators.
@@ -371,16 +688,30 @@ namespace scn {
          * file.sync();
          * result = scn::scan(file, ...);
          * \endcode
+         *
+         * The characters read from the FILE*, but not consumed by a
+         * successful scanning operation, are put back into it:
+         *  - by seeking backwards, if the file is seekable and `char`-oriented
+         *  - otherwise, with `ungetc` (or `ungetwc`). Only a single character
+         *    is guaranteed to be accepted, but glibc, for one, takes any
+         *    number of them.
+         *
+         * The characters that couldn't be put back are kept in this object,
+         * and read first by it, before reading from the FILE* itself.
+         * They won't be visible to `<cstdio>` functions reading from the
+         * handle. If this object is destroyed, or its handle is reset,
+         * they're left to the next `basic_file` reading from the same FILE*,
+         * and need to be discarded with `discard_file_handoff()` before
+         * closing it.
          */
         void sync() noexcept
         {
             _sync_all();
-            m_buffer.clear();
         }
 
         iterator begin() const noexcept
         {
-            return {*this, 0};
+            return {*this, m_window_size != 0 ? m_rollback : m_offset};
         }
         sentinel end() const noexcept
         {
@@ -393,8 +724,10 @@ namespace scn {
             if (!it.m_file) {
                 return {};
             }
+            SCN_EXPECT(it.m_current >= m_offset);
             const auto begin =
-                m_buffer.begin() + static_cast<std::ptrdiff_t>(it.m_current);
+                m_buffer.begin() +
+                static_cast<std::ptrdiff_t>(it.m_current - m_offset);
             const auto end_diff = detail::min(
                 max_size,
                 static_cast<size_t>(ranges::distance(begin, m_buffer.end())));
@@ -404,29 +737,77 @@ namespace scn {
     private:
         friend class iterator;
 
-        expected<CharT> _read_single() const;
+        expected<CharT> _read_some() const;
 
+        // Put back the characters after the rollback point,
+        // keeping only the ones that couldn't be put back in the buffer
         void _sync_all() noexcept
         {
-            _sync_until(m_buffer.size());
+            _sync_until(m_rollback - m_offset);
         }
         void _sync_until(size_t pos) noexcept;
 
+        void _clear_buffer() noexcept
+        {
+            m_buffer.clear();
+            m_offset = 0;
+            m_rollback = 0;
+        }
+        void _take_handoff()
+        {
+            if (m_file) {
+                detail::take_file_handoff(m_file, m_buffer);
+            }
+        }
+        // Leave the characters that couldn't be put back to the next
+        // basic_file reading from m_file
+        void _hand_off() noexcept
+        {
+            if (!m_buffer.empty()) {
+                SCN_TRY
+                {
+                    detail::put_file_handoff(m_file, SCN_MOVE(m_buffer));
+                }
+                SCN_CATCH(const std::bad_alloc&)
+                {
+                    // Nowhere to put the characters: they're lost
+                }
+            }
+            _clear_buffer();
+        }
+
+        // Discard the characters before the rollback point,
+        // if the buffer would otherwise grow past the window
+        void _shrink_to_window(size_t n) const
+        {
+            if (m_window_size == 0 || m_rollback == m_offset ||
+                m_buffer.size() + n <= m_window_size) {
+                return;
+            }
+            m_buffer.erase(0, m_rollback - m_offset);
+            m_offset = m_rollback;
+        }
+
         CharT _get_char_at(size_t i) const
         {
             SCN_EXPECT(valid());
-            SCN_EXPECT(i < m_buffer.size());
-            return m_buffer[i];
+            SCN_EXPECT(i >= m_offset && i - m_offset < m_buffer.size());
+            return m_buffer[i - m_offset];
         }
 
         bool _is_at_end(size_t i) const
         {
             SCN_EXPECT(valid());
-            return i >= m_buffer.size();
+            return i >= m_offset + m_buffer.size();
         }
 
+        // Characters in the buffer, starting from the file position m_offset
         mutable std::basic_string<CharT> m_buffer{};
         FILE* m_file{nullptr};
+        size_t m_block_size{1};
+        size_t m_window_size{0};
+        mutable size_t m_offset{0};
+        mutable size_t m_rollback{0};
     };
 
     using file = basic_file<char>;
@@ -442,14 +823,26 @@ namespace scn {
     bool wfile::iterator::operator==(const wfile::iterator&) const;
 
     template <>
-    expected<char> file::_read_single() const;
+    expected<char> file::_read_some() const;
     template <>
-    expected<wchar_t> wfile::_read_single() const;
+    expected<wchar_t> wfile::_read_some() const;
     template <>
     void file::_sync_until(size_t) noexcept;
     template <>
     void wfile::_sync_until(size_t) noexcept;
 
+    namespace detail {
+        template <typename CharT>
+        struct basic_file_access {
+            // Treat every character read from the FILE* as consumed,
+            // so that sync() doesn't put any of them back
+            static void consume_buffer(const basic_file<CharT>& f) noexcept
+            {
+                f.m_rollback = f.m_offset + f.m_buffer.size();
+            }
+        };
+    }  // namespace detail
+
     /**
      * A child class for basic_file, handling fopen, fclose, and lifetimes with
      * RAII.
@@ -511,6 +904,7 @@ namespace scn {
         {
             SCN_EXPECT(is_open());
             this->sync();
+            discard_file_handoff(this->handle());
             std::fclose(this->handle());
             this->set_handle(nullptr, false);
         }
@@ -525,6 +919,886 @@ namespace scn {
     using owning_file = basic_owning_file<char>;
     using owning_wfile = basic_owning_file<wchar_t>;
 
+    namespace detail {
+        /**
+         * Iterator of a file range, that reads more data on demand.
+         * Positions are absolute, in units of `CharT`, counted from the
+         * beginning of the file.
+         *
+         * `File` needs to provide the following `const` member functions:
+         *  - `error _fill_until(size_t i)`:
+         *    make character `i` readable, or return why it can't be
+         *  - `CharT _get_char_at(size_t i)`: character `i`, after a
+         *    successful `_fill_until(i)`
+         *  - `void _set_rollback_point(size_t i) noexcept`:
+         *    characters before `i` won't be read again
+         *  - `size_t _buffer_begin() noexcept`: position of the first
+         *    character still held, that an iterator can be decremented to
+         */
+        template <typename File, typename CharT>
+        class buffered_file_iterator {
+        public:
+            using char_type = CharT;
+            using value_type = expected<CharT>;
+            using reference = value_type;
+            using pointer = value_type*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using file_type = File;
+
+            buffered_file_iterator() = default;
+
+            expected<CharT> operator*() const
+            {
+                SCN_EXPECT(m_file);
+                if (!m_last_error) {
+                    return m_last_error;
+                }
+                auto e = m_file->_fill_until(m_current);
+                if (!e) {
+                    m_last_error = e;
+                    return e;
+                }
+                return m_file->_get_char_at(m_current);
+            }
+
+            buffered_file_iterator& operator++()
+            {
+                SCN_EXPECT(m_file);
+                ++m_current;
+                return *this;
+            }
+            buffered_file_iterator operator++(int)
+            {
+                buffered_file_iterator tmp(*this);
+                operator++();
+                return tmp;
+            }
+
+            buffered_file_iterator& operator--()
+            {
+                SCN_EXPECT(m_file);
+                SCN_EXPECT(m_current > m_file->_buffer_begin());
+
+                m_last_error = error{};
+                --m_current;
+
+                return *this;
+            }
+            buffered_file_iterator operator--(int)
+            {
+                buffered_file_iterator tmp(*this);
+                operator--();
+                return tmp;
+            }
+
+            bool operator==(const buffered_file_iterator& o) const
+            {
+                // a valid iterator equals null when it's at the end
+                if (m_file && !o.m_file) {
+                    return _is_at_end();
+                }
+                if (!m_file && o.m_file) {
+                    return o._is_at_end();
+                }
+                if (!m_file) {
+                    return true;
+                }
+                return m_file == o.m_file && m_current == o.m_current;
+            }
+            bool operator!=(const buffered_file_iterator& o) const
+            {
+                return !operator==(o);
+            }
+
+            bool operator<(const buffered_file_iterator& o) const
+            {
+                // any valid iterator is before eof and null
+                if (!m_file) {
+                    return !o.m_file;
+                }
+                if (!o.m_file) {
+                    return !m_file;
+                }
+                SCN_EXPECT(m_file == o.m_file);
+                return m_current < o.m_current;
+            }
+            bool operator>(const buffered_file_iterator& o) const
+            {
+                return o.operator<(*this);
+            }
+            bool operator<=(const buffered_file_iterator& o) const
+            {
+                return !operator>(o);
+            }
+            bool operator>=(const buffered_file_iterator& o) const
+            {
+                return !operator<(o);
+            }
+
+            void set_rollback_point() const noexcept
+            {
+                if (m_file) {
+                    m_file->_set_rollback_point(m_current);
+                }
+            }
+
+        private:
+            friend File;
+
+            buffered_file_iterator(const file_type& f, size_t i)
+                : m_file{std::addressof(f)}, m_current{i}
+            {
+            }
+
+            bool _is_at_end() const
+            {
+                if (!m_last_error) {
+                    return true;
+                }
+                auto e = m_file->_fill_until(m_current);
+                if (!e) {
+                    m_last_error = e;
+                    return true;
+                }
+                return false;
+            }
+
+            mutable error m_last_error{};
+            const file_type* m_file{nullptr};
+            size_t m_current{0};
+        };
+
+        class byte_fd_file {
+        public:
+            byte_fd_file() = default;
+            byte_fd_file(int fd, bool owning, size_t buffer_size)
+                : m_buffer_size(buffer_size), m_fd(fd), m_owning(owning)
+            {
+                SCN_EXPECT(buffer_size > 0);
+            }
+
+            byte_fd_file(const byte_fd_file&) = delete;
+            byte_fd_file& operator=(const byte_fd_file&) = delete;
+
+            byte_fd_file(byte_fd_file&& o) noexcept
+                : m_data(SCN_MOVE(o.m_data)),
+                  m_capacity(exchange(o.m_capacity, size_t{0})),
+                  m_size(exchange(o.m_size, size_t{0})),
+                  m_offset(exchange(o.m_offset, size_t{0})),
+                  m_rollback(exchange(o.m_rollback, size_t{0})),
+                  m_buffer_size(o.m_buffer_size),
+                  m_fd(exchange(o.m_fd, -1)),
+                  m_owning(exchange(o.m_owning, false))
+            {
+            }
+            byte_fd_file& operator=(byte_fd_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+
+                m_data = SCN_MOVE(o.m_data);
+                m_capacity = exchange(o.m_capacity, size_t{0});
+                m_size = exchange(o.m_size, size_t{0});
+                m_offset = exchange(o.m_offset, size_t{0});
+                m_rollback = exchange(o.m_rollback, size_t{0});
+                m_buffer_size = o.m_buffer_size;
+                m_fd = exchange(o.m_fd, -1);
+                m_owning = exchange(o.m_owning, false);
+                return *this;
+            }
+
+            ~byte_fd_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const noexcept
+            {
+                return m_fd != -1;
+            }
+
+        protected:
+            // Read until the bytes before the file position `end` are in
+            // the buffer
+            error _fill(size_t end) const;
+            // Read at least one more byte into the buffer
+            error _read_more() const;
+            // Discard the bytes before the rollback point, and make room for
+            // at least `n` more bytes at the end of the buffer
+            void _prepare_append(size_t n) const;
+            // Put unconsumed bytes back, by seeking backwards
+            void _sync() noexcept;
+            void _destruct() noexcept;
+
+            // Bytes in the buffer, starting from the file position m_offset
+            mutable std::unique_ptr<char[]> m_data{};
+            mutable size_t m_capacity{0};
+            mutable size_t m_size{0};
+            mutable size_t m_offset{0};
+            mutable size_t m_rollback{0};
+            size_t m_buffer_size{64 * 1024};
+            int m_fd{-1};
+            bool m_owning{false};
+
+            SCN_NODISCARD const char* _buffer_data() const noexcept
+            {
+                return m_data.get();
+            }
+            SCN_NODISCARD size_t _buffer_size() const noexcept
+            {
+                return m_size;
+            }
+        };
+
+        /**
+         * Range interface shared by the file ranges reading ahead into a
+         * buffer of bytes. `ByteFile` holds the buffer, and provides:
+         *  - `error _fill(size_t end) const`: read until the bytes before
+         *    the position `end` are in the buffer
+         *  - `_buffer_data()` and `_buffer_size()`: the buffer, starting
+         *    from the position `m_offset`
+         *  - `m_rollback`: position of the first byte not yet consumed
+         */
+        template <typename CharT, typename ByteFile>
+        class basic_buffered_file : public ByteFile {
+            friend class buffered_file_iterator<basic_buffered_file, CharT>;
+
+        public:
+            using iterator = buffered_file_iterator<basic_buffered_file, CharT>;
+            using sentinel = iterator;
+            using char_type = CharT;
+
+            using ByteFile::ByteFile;
+
+            iterator begin() const noexcept
+            {
+                return {*this, this->m_rollback / sizeof(CharT)};
+            }
+            sentinel end() const noexcept
+            {
+                return {};
+            }
+
+            span<const CharT> get_buffer(iterator it,
+                                         size_t max_size) const noexcept
+            {
+                if (!it.m_file) {
+                    return {};
+                }
+                const auto end =
+                    (this->m_offset + this->_buffer_size()) / sizeof(CharT);
+                if (it.m_current >= end) {
+                    return {};
+                }
+                SCN_EXPECT(it.m_current * sizeof(CharT) >= this->m_offset);
+                // embrace the UB
+                const auto begin = reinterpret_cast<const CharT*>(
+                    this->_buffer_data() +
+                    (it.m_current * sizeof(CharT) - this->m_offset));
+                return {begin, detail::min(max_size, end - it.m_current)};
+            }
+
+        private:
+            error _fill_until(size_t i) const
+            {
+                return this->_fill((i + 1) * sizeof(CharT));
+            }
+            void _set_rollback_point(size_t i) const noexcept
+            {
+                this->m_rollback = i * sizeof(CharT);
+            }
+            size_t _buffer_begin() const noexcept
+            {
+                // Everything before m_offset has been discarded
+                return this->m_offset / sizeof(CharT);
+            }
+
+            CharT _get_char_at(size_t i) const
+            {
+                SCN_EXPECT(this->valid());
+                SCN_EXPECT(i * sizeof(CharT) >= this->m_offset &&
+                           (i + 1) * sizeof(CharT) <=
+                               this->m_offset + this->_buffer_size());
+                CharT ch{};
+                std::memcpy(&ch,
+                            this->_buffer_data() +
+                                (i * sizeof(CharT) - this->m_offset),
+                            sizeof(CharT));
+                return ch;
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * Range reading from a file descriptor with `read()`, without going
+     * through <cstdio>. Suitable for reading from regular files,
+     * pipes and sockets.
+     *
+     * The file descriptor is read in blocks into an internal buffer,
+     * which is exposed with get_buffer(). The characters consumed by
+     * a successful scanning operation are discarded when the buffer is
+     * refilled, so the buffer only grows if a single value doesn't fit into
+     * it. begin() always points to the first character not yet consumed,
+     * so the file can be scanned repeatedly like a stream:
+     *
+     * \code{.cpp}
+     * auto file = scn::fd_file{sockfd};
+     * int i;
+     * while (scn::scan(file, "{}", i)) {
+     *     // ...
+     * }
+     * \endcode
+     *
+     * Not copyable or reconstructible.
+     */
+    template <typename CharT>
+    class basic_fd_file
+        : public detail::basic_buffered_file<CharT, detail::byte_fd_file> {
+    public:
+        /**
+         * Construct an empty file.
+         * Reading not possible: valid() is `false`
+         */
+        basic_fd_file() = default;
+        /**
+         * Construct from a file descriptor, that must be open for reading.
+         *
+         * If `take_ownership` is `true`, the file descriptor is closed when
+         * this object is destroyed.
+         * `buffer_size` is the size of the internal buffer, in bytes.
+         */
+        explicit basic_fd_file(int fd,
+                               bool take_ownership = false,
+                               size_t buffer_size = 64 * 1024)
+            : detail::basic_buffered_file<CharT, detail::byte_fd_file>(
+                  fd,
+                  take_ownership,
+                  buffer_size)
+        {
+        }
+
+        /// Get the file descriptor for this range
+        SCN_NODISCARD int handle() const noexcept
+        {
+            return this->m_fd;
+        }
+        /// Whether the file descriptor is closed on destruction
+        SCN_NODISCARD bool owns_handle() const noexcept
+        {
+            return this->m_owning;
+        }
+
+        /**
+         * Synchronizes this file with the underlying file descriptor.
+         *
+         * The characters read from the file descriptor, but not consumed by
+         * a successful scanning operation, are put back into it, by seeking
+         * backwards. If the file descriptor isn't seekable, they're kept in
+         * the buffer, and will be read first by this object.
+         *
+         * Called on destruction, if the file descriptor is not owned by this
+         * object.
+         */
+        void sync() noexcept
+        {
+            this->_sync();
+        }
+    };
+
+    using fd_file = basic_fd_file<char>;
+    using fd_wfile = basic_fd_file<wchar_t>;
+
+    namespace detail {
+        class byte_uring_file : public byte_fd_file {
+        public:
+            byte_uring_file() = default;
+            byte_uring_file(int fd,
+                            bool owning,
+                            size_t block_size,
+                            unsigned queue_depth);
+
+            byte_uring_file(byte_uring_file&& o) noexcept;
+            byte_uring_file& operator=(byte_uring_file&& o) noexcept;
+
+            ~byte_uring_file();
+
+        protected:
+            // io_uring instance, and the reads in flight
+            struct uring_state;
+
+            // Same as in byte_fd_file, but with reads queued with io_uring,
+            // if it's available
+            error _fill(size_t end) const;
+            error _read_more() const;
+            void _sync() noexcept;
+            // Stop using io_uring after a failure,
+            // falling back to the reading of byte_fd_file
+            void _drop_uring() const noexcept;
+
+            mutable std::unique_ptr<uring_state> m_uring{};
+        };
+    }  // namespace detail
+
+    /**
+     * Range reading from a file descriptor, like basic_fd_file,
+     * but keeping multiple reads of `block_size` bytes in flight at once,
+     * using io_uring on Linux. This can make better use of fast storage,
+     * on which a single blocking read at a time leaves most of the
+     * bandwidth unused.
+     *
+     * The file descriptor must be seekable for io_uring to be used.
+     * If it's not, or io_uring is not available
+     * (not Linux, too old a kernel, or disabled by a sandbox),
+     * reading is done with `read()`, like with basic_fd_file.
+     *
+     * \code{.cpp}
+     * auto file = scn::uring_file{fd, false, 256 * 1024, 8};
+     * int i;
+     * while (scn::scan(file, "{}", i)) {
+     *     // ...
+     * }
+     * \endcode
+     *
+     * Not copyable or reconstructible.
+     */
+    template <typename CharT>
+    class basic_uring_file
+        : public detail::basic_buffered_file<CharT, detail::byte_uring_file> {
+    public:
+        /**
+         * Construct an empty file.
+         * Reading not possible: valid() is `false`
+         */
+        basic_uring_file() = default;
+        /**
+         * Construct from a file descriptor, that must be open for reading.
+         *
+         * If `take_ownership` is `true`, the file descriptor is closed when
+         * this object is destroyed.
+         * Up to `queue_depth` reads of `block_size` bytes are in flight at
+         * a time.
+         */
+        explicit basic_uring_file(int fd,
+                                  bool take_ownership = false,
+                                  size_t block_size = 64 * 1024,
+                                  unsigned queue_depth = 4)
+            : detail::basic_buffered_file<CharT, detail::byte_uring_file>(
+                  fd,
+                  take_ownership,
+                  block_size,
+                  queue_depth)
+        {
+        }
+
+        /// Get the file descriptor for this range
+        SCN_NODISCARD int handle() const noexcept
+        {
+            return this->m_fd;
+        }
+        /// Whether the file descriptor is closed on destruction
+        SCN_NODISCARD bool owns_handle() const noexcept
+        {
+            return this->m_owning;
+        }
+        /**
+         * Whether io_uring is used, instead of `read()`.
+         * Becomes `false`, if io_uring fails while reading.
+         */
+        SCN_NODISCARD bool uses_io_uring() const noexcept
+        {
+            return this->m_uring != nullptr;
+        }
+
+        /**
+         * Synchronizes this file with the underlying file descriptor,
+         * like basic_fd_file::sync(). The reads still in flight are
+         * waited for, and the file position is set to right after the
+         * characters consumed by a successful scanning operation.
+         *
+         * Called on destruction, if the file descriptor is not owned by this
+         * object.
+         */
+        void sync() noexcept
+        {
+            this->_sync();
+        }
+    };
+
+    using uring_file = basic_uring_file<char>;
+    using uring_wfile = basic_uring_file<wchar_t>;
+
+    namespace detail {
+        class byte_windowed_mapped_file {
+        public:
+            byte_windowed_mapped_file() = default;
+            byte_windowed_mapped_file(const char* filename,
+                                      size_t window_size);
+
+            byte_windowed_mapped_file(const byte_windowed_mapped_file&) =
+                delete;
+            byte_windowed_mapped_file& operator=(
+                const byte_windowed_mapped_file&) = delete;
+
+            byte_windowed_mapped_file(byte_windowed_mapped_file&& o) noexcept
+                : m_map(exchange(o.m_map, span<char>{})),
+                  m_offset(exchange(o.m_offset, size_t{0})),
+                  m_rollback(exchange(o.m_rollback, size_t{0})),
+                  m_file_size(exchange(o.m_file_size, size_t{0})),
+                  m_window_size(exchange(o.m_window_size, size_t{0})),
+                  m_file(exchange(o.m_file, native_file_handle::invalid()))
+            {
+#if SCN_WINDOWS
+                m_map_handle =
+                    exchange(o.m_map_handle, native_file_handle::invalid());
+#endif
+            }
+            byte_windowed_mapped_file& operator=(
+                byte_windowed_mapped_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+
+                m_map = exchange(o.m_map, span<char>{});
+                m_offset = exchange(o.m_offset, size_t{0});
+                m_rollback = exchange(o.m_rollback, size_t{0});
+                m_file_size = exchange(o.m_file_size, size_t{0});
+                m_window_size = exchange(o.m_window_size, size_t{0});
+                m_file = exchange(o.m_file, native_file_handle::invalid());
+#if SCN_WINDOWS
+                m_map_handle =
+                    exchange(o.m_map_handle, native_file_handle::invalid());
+#endif
+                return *this;
+            }
+
+            ~byte_windowed_mapped_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const noexcept
+            {
+                return m_file.handle != native_file_handle::invalid().handle;
+            }
+
+            /// Size of the mapping window, in bytes
+            SCN_NODISCARD size_t window_size() const noexcept
+            {
+                return m_window_size;
+            }
+
+        protected:
+            error _open(const char* filename, size_t window_size);
+            // Make the bytes [begin, end) of the file available in m_map,
+            // remapping if necessary
+            error _fill(size_t begin, size_t end) const;
+            void _unmap() const noexcept;
+            void _destruct() noexcept;
+
+            // Current window, starting from file offset m_offset
+            mutable span<char> m_map{};
+            mutable size_t m_offset{0};
+            mutable size_t m_rollback{0};
+            size_t m_file_size{0};
+            size_t m_window_size{0};
+            native_file_handle m_file{native_file_handle::invalid().handle};
+#if SCN_WINDOWS
+            native_file_handle m_map_handle{
+                native_file_handle::invalid().handle};
+#endif
+        };
+    }  // namespace detail
+
+    /**
+     * Memory-mapped file range, that only maps a window of the file at a
+     * time, instead of the entire file like basic_mapped_file.
+     * Makes it possible to scan files larger than the available address
+     * space, e.g. in 32-bit builds.
+     *
+     * The window is moved forward as the file is read. It's kept covering
+     * the last rollback point, if possible, so that values straddling the
+     * window boundary can be rolled back without remapping.
+     * get_buffer() exposes the current window, but the buffers it returns
+     * are invalidated when the window is moved.
+     *
+     * Like basic_fd_file, begin() always points to the first character
+     * not yet consumed by a successful scanning operation, so the file can
+     * be scanned repeatedly like a stream:
+     *
+     * \code{.cpp}
+     * auto file = scn::windowed_mapped_file{"data.txt"};
+     * int i;
+     * while (scn::scan(file, "{}", i)) {
+     *     // ...
+     * }
+     * \endcode
+     *
+     * Not copyable or reconstructible.
+     */
+    template <typename CharT>
+    class basic_windowed_mapped_file
+        : public detail::byte_windowed_mapped_file {
+        friend class detail::buffered_file_iterator<basic_windowed_mapped_file,
+                                                    CharT>;
+
+    public:
+        using iterator =
+            detail::buffered_file_iterator<basic_windowed_mapped_file, CharT>;
+        using sentinel = iterator;
+        using char_type = CharT;
+
+        /**
+         * Open the file `filename`, mapping `window_size` bytes at a time,
+         * like the constructor.
+         *
+         * Unlike the constructor, reports the reason of a failure with the
+         * returned error. On POSIX, `errno` is also left set to the cause.
+         *
+         * \code{.cpp}
+         * auto file = scn::windowed_mapped_file::open("data.txt");
+         * if (!file) {
+         *     // file.error().msg() == "No such file or directory (ENOENT)"
+         * }
+         * \endcode
+         */
+        static expected<basic_windowed_mapped_file> open(
+            const char* filename,
+            size_t window_size = 1024 * 1024)
+        {
+            basic_windowed_mapped_file f{};
+            auto e = f._open(filename, window_size);
+            if (!e) {
+                return e;
+            }
+            return {SCN_MOVE(f)};
+        }
+
+        /// Constructs an empty mapping
+        basic_windowed_mapped_file() = default;
+
+        /**
+         * Constructs a mapping to a filename, mapping `window_size` bytes at
+         * a time. The window size is rounded up to the page size (or the
+         * allocation granularity on Windows).
+         * On failure, valid() is `false`.
+         *
+         * \see open
+         */
+        explicit basic_windowed_mapped_file(const char* f,
+                                            size_t window_size = 1024 * 1024)
+            : detail::byte_windowed_mapped_file{f, window_size}
+        {
+        }
+
+        /// Size of the file, in characters
+        SCN_NODISCARD size_t size() const noexcept
+        {
+            return m_file_size / sizeof(CharT);
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, m_rollback / sizeof(CharT)};
+        }
+        sentinel end() const noexcept
+        {
+            return {};
+        }
+
+        span<const CharT> get_buffer(iterator it,
+                                     size_t max_size) const noexcept
+        {
+            if (!it.m_file) {
+                return {};
+            }
+            const auto pos = it.m_current * sizeof(CharT);
+            if (pos < m_offset || pos >= m_offset + m_map.size()) {
+                return {};
+            }
+            const auto n = (m_offset + m_map.size() - pos) / sizeof(CharT);
+            // embrace the UB
+            const auto begin =
+                reinterpret_cast<const CharT*>(m_map.data() + (pos - m_offset));
+            return {begin, detail::min(max_size, n)};
+        }
+
+    private:
+        error _fill_until(size_t i) const
+        {
+            return _fill(i * sizeof(CharT), (i + 1) * sizeof(CharT));
+        }
+        void _set_rollback_point(size_t i) const noexcept
+        {
+            m_rollback = i * sizeof(CharT);
+        }
+        size_t _buffer_begin() const noexcept
+        {
+            // The window is remapped from the rollback point:
+            // everything before it is considered discarded
+            return m_rollback / sizeof(CharT);
+        }
+
+        CharT _get_char_at(size_t i) const
+        {
+            SCN_EXPECT(i * sizeof(CharT) >= m_offset &&
+                       (i + 1) * sizeof(CharT) <= m_offset + m_map.size());
+            CharT ch{};
+            std::memcpy(&ch, m_map.data() + (i * sizeof(CharT) - m_offset),
+                        sizeof(CharT));
+            return ch;
+        }
+    };
+
+    using windowed_mapped_file = basic_windowed_mapped_file<char>;
+    using windowed_mapped_wfile = basic_windowed_mapped_file<wchar_t>;
+
+    namespace detail {
+        class byte_prefetching_file {
+        public:
+            byte_prefetching_file() = default;
+            byte_prefetching_file(FILE* f,
+                                  bool wide,
+                                  size_t block_size,
+                                  size_t blocks);
+
+            byte_prefetching_file(const byte_prefetching_file&) = delete;
+            byte_prefetching_file& operator=(const byte_prefetching_file&) =
+                delete;
+
+            byte_prefetching_file(byte_prefetching_file&& o) noexcept;
+            byte_prefetching_file& operator=(
+                byte_prefetching_file&& o) noexcept;
+
+            ~byte_prefetching_file();
+
+            SCN_NODISCARD bool valid() const noexcept
+            {
+                return m_file != nullptr;
+            }
+
+        protected:
+            // State shared with the reader thread
+            struct shared_state;
+
+            // Wait until the bytes before the position `end` are in the
+            // buffer
+            error _fill(size_t end) const;
+            // Take the next block read by the reader thread
+            error _read_more() const;
+            // Stop the reader thread, and put everything not consumed back
+            // into the FILE*
+            void _sync() noexcept;
+            void _destruct() noexcept;
+
+            // Bytes in the buffer, starting from the position m_offset
+            mutable std::string m_buffer{};
+            mutable size_t m_offset{0};
+            mutable size_t m_rollback{0};
+            mutable std::unique_ptr<shared_state> m_state{};
+            FILE* m_file{nullptr};
+
+            SCN_NODISCARD const char* _buffer_data() const noexcept
+            {
+                return m_buffer.data();
+            }
+            SCN_NODISCARD size_t _buffer_size() const noexcept
+            {
+                return m_buffer.size();
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * Range reading from a C FILE*, with the reading done in advance on a
+     * background thread: while the scanning thread parses a block, the
+     * next ones are already being read. Useful when reading is slow
+     * (network storage, pipes), and would otherwise stall scanning.
+     *
+     * Reading starts on first access, at most `blocks` blocks of
+     * `block_size` characters are read ahead.
+     * Like basic_fd_file, begin() always points to the first character
+     * not yet consumed by a successful scanning operation,
+     * and the buffer is exposed with get_buffer().
+     *
+     * \code{.cpp}
+     * auto in = scn::prefetching_file{stdin};
+     * int i;
+     * while (scn::scan(in, "{}", i)) {
+     *     // ...
+     * }
+     * \endcode
+     *
+     * The FILE* must not be used by anything else while this object is
+     * reading from it, until sync() is called or this object is destroyed.
+     * A block is only handed to the scanner once it's full, or the file is
+     * at EOF, so this is not suitable for interactive input.
+     *
+     * Not copyable or reconstructible.
+     */
+    template <typename CharT>
+    class basic_prefetching_file
+        : public detail::basic_buffered_file<CharT,
+                                             detail::byte_prefetching_file> {
+    public:
+        /**
+         * Construct an empty file.
+         * Reading not possible: valid() is `false`
+         */
+        basic_prefetching_file() = default;
+        /**
+         * Construct from a FILE*.
+         * `block_size` is the size of a single read, in characters,
+         * and `blocks` the number of blocks that are read ahead.
+         */
+        explicit basic_prefetching_file(FILE* f,
+                                        size_t block_size = 64 * 1024,
+                                        size_t blocks = 2)
+            : detail::basic_buffered_file<CharT,
+                                          detail::byte_prefetching_file>(
+                  f,
+                  std::is_same<CharT, wchar_t>::value,
+                  block_size * sizeof(CharT),
+                  blocks)
+        {
+            std::basic_string<CharT> handoff{};
+            detail::take_file_handoff(f, handoff);
+            this->m_buffer.assign(
+                reinterpret_cast<const char*>(handoff.data()),
+                handoff.size() * sizeof(CharT));
+        }
+
+        /// Get the FILE* for this range
+        SCN_NODISCARD FILE* handle() const noexcept
+        {
+            return this->m_file;
+        }
+
+        /**
+         * Stops the background reading, and synchronizes this file with the
+         * underlying FILE*: the characters read ahead, but not consumed by
+         * a successful scanning operation, are put back into it,
+         * like with basic_file::sync().
+         * Reading from this object afterwards starts the background reading
+         * again.
+         *
+         * Called on destruction.
+         */
+        void sync() noexcept
+        {
+            this->_sync();
+        }
+    };
+
+    using prefetching_file = basic_prefetching_file<char>;
+    using prefetching_wfile = basic_prefetching_file<wchar_t>;
+
     SCN_CLANG_PUSH
     SCN_CLANG_IGNORE("-Wexit-time-destructors")
 
@@ -122,6 +122,20 @@ namespace scn {
     class basic_file;
     template <typename CharT>
     class basic_owning_file;
+    template <typename CharT>
+    class basic_fd_file;
+    template <typename CharT>
+    class basic_uring_file;
+    template <typename CharT>
+    class basic_windowed_mapped_file;
+    template <typename CharT>
+    class basic_prefetching_file;
+
+    // reader/decimal.h
+
+    enum class decimal_rounding;
+    template <typename T, unsigned Scale, decimal_rounding Rounding>
+    struct decimal;
 
     // scan.h
 
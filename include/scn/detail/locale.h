@@ -433,6 +433,14 @@ namespace scn {
             bool is_digit(code_point) const;
             using base::is_digit;
 
+            /**
+             * Digit grouping of the locale, as returned by
+             * `std::numpunct::grouping()`.
+             * Cached on construction, like the decimal point and
+             * the thousands separator.
+             */
+            string_view grouping() const;
+
             template <typename T>
             expected<std::ptrdiff_t> read_num(T& val,
                                               const string_type& buf,
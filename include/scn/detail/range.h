@@ -59,6 +59,37 @@ namespace scn {
                 static_const<detail::_reset_begin_iterator::fn>::value;
         }
 
+        namespace _set_rollback_point {
+            struct fn {
+            private:
+                template <typename Iterator>
+                static auto impl(Iterator& it, priority_tag<1>) noexcept(
+                    noexcept(it.set_rollback_point()))
+                    -> decltype(it.set_rollback_point())
+                {
+                    return it.set_rollback_point();
+                }
+
+                template <typename Iterator>
+                static void impl(Iterator&, priority_tag<0>) noexcept
+                {
+                }
+
+            public:
+                template <typename Iterator>
+                auto operator()(Iterator& it) const
+                    noexcept(noexcept(fn::impl(it, priority_tag<1>{})))
+                        -> decltype(fn::impl(it, priority_tag<1>{}))
+                {
+                    return fn::impl(it, priority_tag<1>{});
+                }
+            };
+        }  // namespace _set_rollback_point
+        namespace {
+            static constexpr auto& set_rollback_point =
+                static_const<detail::_set_rollback_point::fn>::value;
+        }
+
         template <typename Iterator, typename = void>
         struct extract_char_type;
         template <typename Iterator>
@@ -361,13 +392,32 @@ namespace scn {
             struct dummy2 {
             };
 
+            /**
+             * Returns the buffer of at most `max_size` characters starting
+             * from `begin()`, without advancing.
+             *
+             * Prefer this over `get_buffer_and_advance()` when only a part of
+             * the buffer may be consumed: advance by the number of
+             * characters actually read afterwards. With a non-contiguous
+             * range, advancing and putting back are linear in the number of
+             * characters.
+             */
+            template <typename R = range_nocvref_type,
+                      typename std::enable_if<provides_buffer_access_impl<
+                          R>::value>::type* = nullptr>
+            span<const char_type> peek_buffer(
+                size_t max_size = std::numeric_limits<size_t>::max()) const
+            {
+                return get_buffer(m_range.get(), begin(), max_size);
+            }
+
             template <typename R = range_nocvref_type,
                       typename std::enable_if<provides_buffer_access_impl<
                           R>::value>::type* = nullptr>
             span<const char_type> get_buffer_and_advance(
                 size_t max_size = std::numeric_limits<size_t>::max())
             {
-                auto buf = get_buffer(m_range.get(), begin(), max_size);
+                auto buf = peek_buffer(max_size);
                 if (buf.size() == 0) {
                     return buf;
                 }
@@ -397,11 +447,16 @@ namespace scn {
             /**
              * Sets the rollback point equal to the current `begin()` iterator.
              *
+             * If the iterator has a member function `set_rollback_point()`,
+             * it's called, to let the source range know that the characters
+             * before it won't be read again.
+             *
              * \see reset_to_rollback_point()
              */
             void set_rollback_point()
             {
                 m_read = 0;
+                detail::set_rollback_point(m_begin);
             }
 
             void reset_begin_iterator()
@@ -75,6 +75,10 @@ namespace scn {
         SCN_VISIT_INT(unsigned long)
         SCN_VISIT_INT(unsigned long long)
         SCN_VISIT_INT(char_type)
+#if SCN_HAS_INT128
+        SCN_VISIT_INT(detail::int128)
+        SCN_VISIT_INT(detail::uint128)
+#endif
 #undef SCN_VISIT_INT
 
 #define SCN_VISIT_FLOAT(T)                                            \
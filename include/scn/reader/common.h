@@ -640,18 +640,16 @@ namespace scn {
         {
             if (!pred.is_multibyte()) {
                 while (r.begin() != r.end() && !done) {
-                    auto s = r.get_buffer_and_advance();
-                    for (auto it = s.begin(); it != s.end() && out_cmp(out);
-                         ++it) {
+                    // Only advance past what's consumed: the buffer may
+                    // extend far beyond the end of the value
+                    auto s = r.peek_buffer();
+                    auto it = s.begin();
+                    for (; it != s.end() && out_cmp(out); ++it) {
                         if (pred(make_span(&*it, 1)) == pred_result_to_stop) {
                             if (keep_final) {
                                 *out = *it;
                                 ++out;
-                            }
-                            auto e =
-                                putback_n(r, ranges::distance(it, s.end()));
-                            if (!e) {
-                                return e;
+                                ++it;
                             }
                             done = true;
                             break;
@@ -659,6 +657,7 @@ namespace scn {
                         *out = *it;
                         ++out;
                     }
+                    r.advance(ranges::distance(s.begin(), it));
                     if (!done && out_cmp(out)) {
                         auto ret = read_code_unit(r, false);
                         if (!ret) {
@@ -685,28 +684,27 @@ namespace scn {
             }
             else {
                 while (r.begin() != r.end() && !done) {
-                    auto s = r.get_buffer_and_advance();
-                    for (auto it = s.begin(); it != s.end() && out_cmp(out);) {
+                    auto s = r.peek_buffer();
+                    auto it = s.begin();
+                    for (; it != s.end() && out_cmp(out);) {
                         auto len = ::scn::get_sequence_length(*it);
                         if (len == 0) {
+                            r.advance(ranges::distance(s.begin(), it));
                             return error{error::invalid_encoding,
                                          "Invalid code point"};
                         }
                         if (ranges::distance(it, s.end()) < len) {
-                            auto e = putback_n(r, len);
-                            if (!e) {
-                                return e;
-                            }
                             break;
                         }
                         auto cpspan = make_span(it, static_cast<size_t>(len));
                         code_point cp{};
                         auto i =
                             parse_code_point(cpspan.begin(), cpspan.end(), cp);
-                        if (!i) {
-                            return i.error();
-                        }
-                        if (i.value() != cpspan.end()) {
+                        if (!i || i.value() != cpspan.end()) {
+                            r.advance(ranges::distance(s.begin(), it));
+                            if (!i) {
+                                return i.error();
+                            }
                             return error{error::invalid_encoding,
                                          "Invalid code point"};
                         }
@@ -714,12 +712,15 @@ namespace scn {
                             if (keep_final) {
                                 out = std::copy(cpspan.begin(), cpspan.end(),
                                                 out);
+                                it += len;
                             }
                             done = true;
                             break;
                         }
                         out = std::copy(cpspan.begin(), cpspan.end(), out);
+                        it += len;
                     }
+                    r.advance(ranges::distance(s.begin(), it));
 
                     if (!done && out_cmp(out)) {
                         alignas(typename WrappedRange::char_type) unsigned char
@@ -1165,6 +1166,48 @@ namespace scn {
                 int base = 10,
                 uint16_t flags = 0);
         };
+
+        /**
+         * Verify the sizes of the digit groups in digits, separated by
+         * thsep, against grouping (as returned by
+         * `std::numpunct::grouping()`). Groups are checked from right to
+         * left: the last grouping entry repeats, and the leftmost group may
+         * be shorter.
+         */
+        template <typename CharT>
+        error check_digit_grouping(span<const CharT> digits,
+                                   CharT thsep,
+                                   string_view grouping)
+        {
+            const auto no_grouping = [](char len) {
+                return len <= 0 || len == std::numeric_limits<char>::max();
+            };
+
+            std::size_t group_idx = 0;
+            std::ptrdiff_t group_len = 0;
+            for (auto rit = digits.end(); rit != digits.begin();) {
+                --rit;
+                if (*rit != thsep) {
+                    ++group_len;
+                    continue;
+                }
+                const auto expected_len = grouping[group_idx];
+                if (no_grouping(expected_len) || group_len != expected_len) {
+                    return {error::invalid_scanned_value,
+                            "Invalid digit grouping"};
+                }
+                if (group_idx + 1 < grouping.size()) {
+                    ++group_idx;
+                }
+                group_len = 0;
+            }
+            const auto expected_len = grouping[group_idx];
+            if (!no_grouping(expected_len) && group_len > expected_len) {
+                return {error::invalid_scanned_value,
+                        "Invalid digit grouping"};
+            }
+            return {};
+        }
     }  // namespace detail
 
     /**
@@ -1376,6 +1419,47 @@ namespace scn {
             return {};
         }
 
+        /**
+         * Parse the digit grouping flag `'` at `pctx.next_char()`,
+         * optionally followed by the separator: any character other than a
+         * digit or a letter. For use in a `type_cb` of `parse_common`.
+         *
+         * Sets `thsep_set`, and `thsep_char`, if a separator was given.
+         * Returns `error::invalid_format_string`, if `thsep_set` was
+         * already `true`.
+         */
+        template <typename ParseCtx>
+        static error parse_thsep_flag(ParseCtx& pctx,
+                                      bool& thsep_set,
+                                      char32_t& thsep_char)
+        {
+            using char_type = typename ParseCtx::char_type;
+            SCN_EXPECT(pctx.next_char() ==
+                       detail::ascii_widen<char_type>('\''));
+
+            if (SCN_UNLIKELY(thsep_set)) {
+                return {error::invalid_format_string,
+                        "Repeat flag in format string"};
+            }
+            thsep_set = true;
+            pctx.advance_char();
+            if (!pctx || pctx.check_arg_end()) {
+                return {};
+            }
+
+            const auto ch = pctx.next_char();
+            const auto lower = static_cast<char_type>(
+                ch | detail::ascii_widen<char_type>(' '));
+            if (!(ch >= detail::ascii_widen<char_type>('0') &&
+                  ch <= detail::ascii_widen<char_type>('9')) &&
+                !(lower >= detail::ascii_widen<char_type>('a') &&
+                  lower <= detail::ascii_widen<char_type>('z'))) {
+                thsep_char = static_cast<char32_t>(ch);
+                pctx.advance_char();
+            }
+            return {};
+        }
+
     public:
         /**
          * Parse a format string argument, using `parse_common_begin`,
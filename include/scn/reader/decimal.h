@@ -0,0 +1,315 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_READER_DECIMAL_H
+#define SCN_READER_DECIMAL_H
+
+#include "../util/algorithm.h"
+#include "../util/small_vector.h"
+#include "int.h"
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * What to do with fractional digits beyond the scale of a `decimal`.
+     */
+    enum class decimal_rounding {
+        /// Fail with `error::invalid_scanned_value`,
+        /// unless every excess digit is zero
+        reject,
+        /// Drop the excess digits (round toward zero)
+        truncate,
+        /// Round to nearest, ties away from zero
+        half_up,
+        /// Round to nearest, ties to even
+        half_even
+    };
+
+    /**
+     * A fixed-point number, stored as an integral count of `10^-Scale`:
+     * `decimal<std::int64_t, 4>{12345}` is `1.2345`.
+     *
+     * The digits are scanned straight into `value`, without going through
+     * a floating-point type. Only plain decimal notation is accepted
+     * (`[+-]digits[.digits]`), and the decimal point is `'.'`, or the
+     * one of the locale with the `L` flag.
+     *
+     * \code{.cpp}
+     * scn::decimal<long long, 2> price{};
+     * auto result = scn::scan("19.99", "{}", price);
+     * // price.value == 1999
+     * \endcode
+     */
+    template <typename T,
+              unsigned Scale,
+              decimal_rounding Rounding = decimal_rounding::reject>
+    struct decimal {
+        static_assert(detail::int_traits<T>::is_integral,
+                      "decimal requires an integral type");
+        static_assert(Scale <= detail::int_traits<T>::digits10,
+                      "decimal scale doesn't fit into T");
+
+        using value_type = T;
+        static constexpr unsigned scale = Scale;
+        static constexpr decimal_rounding rounding = Rounding;
+
+        value_type value{};
+    };
+
+    template <typename T, unsigned Scale, decimal_rounding Rounding>
+    constexpr unsigned decimal<T, Scale, Rounding>::scale;
+    template <typename T, unsigned Scale, decimal_rounding Rounding>
+    constexpr decimal_rounding decimal<T, Scale, Rounding>::rounding;
+
+    namespace detail {
+        template <typename T, unsigned Scale, decimal_rounding Rounding>
+        struct decimal_scanner : common_parser {
+            template <typename ParseCtx>
+            error parse(ParseCtx& pctx)
+            {
+                using char_type = typename ParseCtx::char_type;
+                return parse_common(pctx, span<const char_type>{},
+                                    span<bool>{}, null_type_cb<ParseCtx>);
+            }
+
+            template <typename Context>
+            error scan(decimal<T, Scale, Rounding>& val, Context& ctx)
+            {
+                using char_type = typename Context::char_type;
+
+                auto do_parse = [&](span<const char_type> s) -> error {
+                    T tmp = 0;
+                    auto ret = _parse_decimal(
+                        tmp, s,
+                        ctx.locale()
+                            .get((common_options & localized) != 0)
+                            .decimal_point());
+                    if (!ret) {
+                        return ret.error();
+                    }
+                    if (ret.value() != s.ssize()) {
+                        auto pb =
+                            putback_n(ctx.range(), s.ssize() - ret.value());
+                        if (!pb) {
+                            return pb;
+                        }
+                    }
+                    val.value = tmp;
+                    return {};
+                };
+
+                auto is_space_pred = make_is_space_predicate(
+                    ctx.locale(), (common_options & localized) != 0,
+                    field_width);
+
+                if (Context::range_type::is_contiguous) {
+                    auto s = read_until_space_zero_copy(ctx.range(),
+                                                        is_space_pred, false);
+                    if (!s) {
+                        return s.error();
+                    }
+                    return do_parse(s.value());
+                }
+
+                small_vector<char_type, 32> buf;
+                auto outputit = std::back_inserter(buf);
+                auto e = read_until_space(ctx.range(), outputit, is_space_pred,
+                                          false);
+                if (!e && buf.empty()) {
+                    return e;
+                }
+
+                return do_parse(make_span(buf));
+            }
+
+        private:
+            using utype = typename int_traits<T>::unsigned_type;
+
+            static constexpr utype _pow10(unsigned n)
+            {
+                return n == 0 ? utype{1}
+                              : static_cast<utype>(10 * _pow10(n - 1));
+            }
+
+            template <typename CharT>
+            static bool _is_digit(CharT ch)
+            {
+                return ch >= ascii_widen<CharT>('0') &&
+                       ch <= ascii_widen<CharT>('9');
+            }
+
+            /**
+             * Parse `[+-]digits[.digits]` from the beginning of s into val,
+             * scaled by 10^Scale. The digit runs are read with the integer
+             * reader, so only the digits past the scale are looked at one by
+             * one. Returns the number of characters read.
+             */
+            template <typename CharT>
+            static expected<std::ptrdiff_t> _parse_decimal(
+                T& val,
+                span<const CharT> s,
+                CharT decimal_point)
+            {
+                SCN_GCC_PUSH
+                SCN_GCC_IGNORE("-Wconversion")
+                SCN_GCC_IGNORE("-Wsign-conversion")
+                SCN_GCC_IGNORE("-Wsign-compare")
+
+                SCN_CLANG_PUSH
+                SCN_CLANG_IGNORE("-Wconversion")
+                SCN_CLANG_IGNORE("-Wsign-conversion")
+                SCN_CLANG_IGNORE("-Wsign-compare")
+
+                SCN_MSVC_PUSH
+                SCN_MSVC_IGNORE(4018)  // > signed/unsigned mismatch
+                SCN_MSVC_IGNORE(4127)  // conditional expression is constant
+                SCN_MSVC_IGNORE(4146)  // unary minus on unsigned
+                SCN_MSVC_IGNORE(4244)  // lossy conversion
+
+                auto it = s.begin();
+                const auto end = s.end();
+
+                bool minus_sign = false;
+                if (it != end && (*it == ascii_widen<CharT>('-') ||
+                                  *it == ascii_widen<CharT>('+'))) {
+                    minus_sign = *it == ascii_widen<CharT>('-');
+                    ++it;
+                }
+                if (minus_sign && !int_traits<T>::is_signed) {
+                    return error{error::invalid_scanned_value,
+                                 "Unexpected sign '-' when scanning an "
+                                 "unsigned decimal"};
+                }
+
+                utype int_part = 0;
+                const auto int_begin = it;
+                if (it != end && _is_digit(*it)) {
+                    auto r = simple_integer_scanner<utype>::scan_lower(
+                        make_span(it, end), int_part, 10);
+                    if (!r) {
+                        return r.error();
+                    }
+                    it = r.value();
+                }
+                bool has_digits = it != int_begin;
+
+                utype frac = 0;
+                bool round_up = false;
+                if (it != end && *it == decimal_point) {
+                    const auto frac_begin = it + 1;
+                    auto frac_end = frac_begin;
+                    if (Scale != 0 && frac_end != end && _is_digit(*frac_end)) {
+                        const auto n =
+                            detail::min(end - frac_begin,
+                                        static_cast<std::ptrdiff_t>(Scale));
+                        auto r = simple_integer_scanner<utype>::scan_lower(
+                            make_span(frac_begin, frac_begin + n), frac, 10);
+                        if (!r) {
+                            return r.error();
+                        }
+                        frac_end = r.value();
+                    }
+                    frac = static_cast<utype>(
+                        frac * _pow10(Scale - static_cast<unsigned>(
+                                                  frac_end - frac_begin)));
+
+                    // digits past the scale
+                    auto excess_end = frac_end;
+                    bool nonzero_tail = false;
+                    if (excess_end != end && _is_digit(*excess_end)) {
+                        while (++excess_end != end && _is_digit(*excess_end)) {
+                            nonzero_tail =
+                                nonzero_tail ||
+                                *excess_end != ascii_widen<CharT>('0');
+                        }
+                        const auto first = *frac_end - ascii_widen<CharT>('0');
+                        const bool odd =
+                            ((Scale == 0 ? int_part : frac) & 1u) != 0;
+                        if (Rounding == decimal_rounding::reject) {
+                            if (first != 0 || nonzero_tail) {
+                                return error{error::invalid_scanned_value,
+                                             "Too many fractional digits for "
+                                             "the scale of the decimal"};
+                            }
+                        }
+                        else if (Rounding == decimal_rounding::half_up) {
+                            round_up = first >= 5;
+                        }
+                        else if (Rounding == decimal_rounding::half_even) {
+                            round_up = first > 5 ||
+                                       (first == 5 && (nonzero_tail || odd));
+                        }
+                    }
+
+                    has_digits = has_digits || excess_end != frac_begin;
+                    if (has_digits) {
+                        it = excess_end;
+                    }
+                }
+                if (!has_digits) {
+                    return error{error::invalid_scanned_value,
+                                 "Expected a decimal number"};
+                }
+
+                // int_part * 10^Scale + frac + round_up <= limit,
+                // where frac + round_up <= 10^Scale <= limit
+                const auto umax = static_cast<utype>(~utype{0});
+                const auto limit = static_cast<utype>(
+                    (int_traits<T>::is_signed ? umax >> 1 : umax) +
+                    (minus_sign ? 1 : 0));
+                const auto low = static_cast<utype>(frac + (round_up ? 1 : 0));
+                if (SCN_UNLIKELY(int_part > (limit - low) / _pow10(Scale))) {
+                    if (minus_sign) {
+                        return error(error::value_out_of_range,
+                                     "Out of range: decimal underflow");
+                    }
+                    return error(error::value_out_of_range,
+                                 "Out of range: decimal overflow");
+                }
+                const auto mag =
+                    static_cast<utype>(int_part * _pow10(Scale) + low);
+
+                if (minus_sign) {
+                    if (SCN_UNLIKELY(mag == limit)) {
+                        val = int_traits<T>::min();
+                    }
+                    else {
+                        val = -static_cast<T>(mag);
+                    }
+                }
+                else {
+                    val = static_cast<T>(mag);
+                }
+                return it - s.begin();
+
+                SCN_MSVC_POP
+                SCN_CLANG_POP
+                SCN_GCC_POP
+            }
+        };
+    }  // namespace detail
+
+    template <typename T, unsigned Scale, decimal_rounding Rounding>
+    struct scanner<decimal<T, Scale, Rounding>>
+        : public detail::decimal_scanner<T, Scale, Rounding> {
+    };
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif
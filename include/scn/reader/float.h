@@ -39,7 +39,7 @@ namespace scn {
             {
                 using char_type = typename ParseCtx::char_type;
 
-                array<char_type, 10> options{
+                array<char_type, 9> options{
                     {// hex
                      ascii_widen<char_type>('a'), ascii_widen<char_type>('A'),
                      // scientific
@@ -49,14 +49,22 @@ namespace scn {
                      // general
                      ascii_widen<char_type>('g'), ascii_widen<char_type>('G'),
                      // localized digits
-                     ascii_widen<char_type>('n'),
-                     // thsep
-                     ascii_widen<char_type>('\'')}};
-                bool flags[10] = {false};
+                     ascii_widen<char_type>('n')}};
+                bool flags[9] = {false};
+
+                bool thsep_set = false;
+                auto each = [&](ParseCtx& p, bool& parsed) -> error {
+                    parsed = false;
+                    if (p.next_char() != ascii_widen<char_type>('\'')) {
+                        return {};
+                    }
+                    parsed = true;
+                    return parse_thsep_flag(p, thsep_set, thsep_char);
+                };
 
                 auto e = parse_common(
                     pctx, span<const char_type>{options.begin(), options.end()},
-                    span<bool>{flags, 10}, null_type_cb<ParseCtx>);
+                    span<bool>{flags, 9}, each);
                 if (!e) {
                     return e;
                 }
@@ -116,7 +124,7 @@ namespace scn {
                 }
 
                 // thsep
-                if (flags[9]) {
+                if (thsep_set) {
                     format_options |= allow_thsep;
                 }
 
@@ -131,25 +139,42 @@ namespace scn {
                 auto do_parse_float = [&](span<const char_type> s) -> error {
                     T tmp = 0;
                     expected<std::ptrdiff_t> ret{0};
-                    if (SCN_UNLIKELY((format_options & localized_digits) != 0 ||
-                                     ((common_options & localized) != 0 &&
-                                      (format_options & allow_hex) != 0))) {
-                        // 'n' OR ('L' AND 'a')
-                        // because none of our parsers support BOTH hexfloats
-                        // and custom (localized) decimal points,
-                        // so we have to fall back on iostreams
+                    const auto& loc =
+                        ctx.locale().get((common_options & localized) != 0);
+                    if (SCN_UNLIKELY((format_options & localized_digits) !=
+                                     0)) {
+                        // 'n': digits grouped according to the locale
                         SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                        std::basic_string<char_type> str(s.data(), s.size());
-                        ret =
-                            ctx.locale().get_localized().read_num(tmp, str, 0);
+                        const auto& custom = ctx.locale().get_localized();
+                        const auto grouping = custom.grouping();
+                        if (grouping.size() != 0 && grouping[0] > 0 &&
+                            grouping[0] != std::numeric_limits<char>::max()) {
+                            ret = _read_float_grouped(
+                                tmp, s, custom.decimal_point(),
+                                custom.thousands_separator(), grouping);
+                        }
+                        else {
+                            ret = _read_float(tmp, s, custom.decimal_point());
+                        }
                         SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     }
+                    else if (SCN_UNLIKELY((format_options & allow_thsep) !=
+                                          0)) {
+                        // "'": any thousands separators in the integer part
+                        const auto sep =
+                            thsep_char != 0
+                                ? static_cast<char_type>(thsep_char)
+                                : loc.thousands_separator();
+                        if (SCN_UNLIKELY(sep == loc.decimal_point())) {
+                            return {error::invalid_format_string,
+                                    "Thousands separator can't be the "
+                                    "decimal point"};
+                        }
+                        ret = _read_float_grouped(tmp, s, loc.decimal_point(),
+                                                  sep, string_view{});
+                    }
                     else {
-                        ret = _read_float(
-                            tmp, s,
-                            ctx.locale()
-                                .get((common_options & localized) != 0)
-                                .decimal_point());
+                        ret = _read_float(tmp, s, loc.decimal_point());
                     }
 
                     if (!ret) {
@@ -199,6 +224,10 @@ namespace scn {
             };
             uint8_t format_options{allow_hex | allow_scientific | allow_fixed};
 
+            // "'" option: digit group separator,
+            // 0 = thousands separator of the locale
+            char32_t thsep_char{0};
+
         private:
             template <typename CharT>
             expected<std::ptrdiff_t> _read_float(T& val,
@@ -206,10 +235,8 @@ namespace scn {
                                                  CharT locale_decimal_point)
             {
                 size_t chars{};
-                std::basic_string<CharT> str(s.data(), s.size());
                 SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                auto ret =
-                    _read_float_impl(str.data(), chars, locale_decimal_point);
+                auto ret = _read_float_impl(s, chars, locale_decimal_point);
                 SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                 if (!ret) {
                     return ret.error();
@@ -218,8 +245,78 @@ namespace scn {
                 return static_cast<std::ptrdiff_t>(chars);
             }
 
+            /**
+             * Like _read_float, but the integer part may contain thsep
+             * between its digits. The separators are removed from a copy of
+             * s, which is then parsed as usual. If grouping is not empty,
+             * the group sizes are checked against it.
+             */
+            template <typename CharT>
+            expected<std::ptrdiff_t> _read_float_grouped(
+                T& val,
+                span<const CharT> s,
+                CharT locale_decimal_point,
+                CharT thsep,
+                string_view grouping)
+            {
+                const auto is_digit = [](CharT ch) {
+                    return ch >= ascii_widen<CharT>('0') &&
+                           ch <= ascii_widen<CharT>('9');
+                };
+
+                auto it = s.begin();
+                const auto end = s.end();
+                if (it != end && (*it == ascii_widen<CharT>('-') ||
+                                  *it == ascii_widen<CharT>('+'))) {
+                    ++it;
+                }
+                const auto digits_begin = it;
+                std::ptrdiff_t separators = 0;
+                for (; it != end; ++it) {
+                    if (is_digit(*it)) {
+                        continue;
+                    }
+                    if (*it == thsep && it != digits_begin && it + 1 != end &&
+                        is_digit(*(it + 1))) {
+                        ++separators;
+                        continue;
+                    }
+                    break;
+                }
+                const auto digits_end = it;
+                if (separators == 0) {
+                    return _read_float(val, s, locale_decimal_point);
+                }
+                if (grouping.size() != 0) {
+                    auto e = check_digit_grouping(
+                        make_span(digits_begin, digits_end), thsep, grouping);
+                    if (!e) {
+                        return e;
+                    }
+                }
+
+                small_vector<CharT, 64> buf;
+                buf.reserve(s.size() - static_cast<size_t>(separators));
+                for (auto ch = s.begin(); ch != end; ++ch) {
+                    if (ch < digits_begin || ch >= digits_end ||
+                        *ch != thsep) {
+                        buf.push_back(*ch);
+                    }
+                }
+                auto ret =
+                    _read_float(val, span<const CharT>{buf.data(), buf.size()},
+                                locale_decimal_point);
+                if (!ret) {
+                    return ret;
+                }
+                // Every parser reads all of the integer digits
+                SCN_ENSURE(ret.value() >=
+                           (digits_end - s.begin()) - separators);
+                return ret.value() + separators;
+            }
+
             template <typename CharT>
-            expected<T> _read_float_impl(const CharT* str,
+            expected<T> _read_float_impl(span<const CharT> s,
                                          size_t& chars,
                                          CharT locale_decimal_point);
         };
@@ -25,9 +25,57 @@ namespace scn {
     SCN_BEGIN_NAMESPACE
 
     namespace detail {
+        /**
+         * The parts of `std::numeric_limits` and `<type_traits>` used by
+         * integer_scanner. Unlike the standard ones, also covers
+         * `__int128` in strict (non-GNU) language modes.
+         */
+        template <typename T>
+        struct int_traits {
+            using unsigned_type = typename std::make_unsigned<T>::type;
+            static constexpr bool is_integral = std::is_integral<T>::value;
+            static constexpr bool is_signed = std::is_signed<T>::value;
+            static constexpr int digits10 = std::numeric_limits<T>::digits10;
+            static constexpr int unsigned_digits =
+                std::numeric_limits<unsigned_type>::digits;
+
+            static constexpr T min() noexcept
+            {
+                return (std::numeric_limits<T>::min)();
+            }
+        };
+#if SCN_HAS_INT128
+        template <>
+        struct int_traits<int128> {
+            using unsigned_type = uint128;
+            static constexpr bool is_integral = true;
+            static constexpr bool is_signed = true;
+            static constexpr int digits10 = 38;
+            static constexpr int unsigned_digits = 128;
+
+            static constexpr int128 min() noexcept
+            {
+                return static_cast<int128>(uint128{1} << 127);
+            }
+        };
+        template <>
+        struct int_traits<uint128> {
+            using unsigned_type = uint128;
+            static constexpr bool is_integral = true;
+            static constexpr bool is_signed = false;
+            static constexpr int digits10 = 38;
+            static constexpr int unsigned_digits = 128;
+
+            static constexpr uint128 min() noexcept
+            {
+                return 0;
+            }
+        };
+#endif
+
         template <typename T>
         struct integer_scanner : common_parser {
-            static_assert(std::is_integral<T>::value,
+            static_assert(int_traits<T>::is_integral,
                           "integer_scanner requires an integral type");
 
             friend struct simple_integer_scanner<T>;
@@ -47,10 +95,16 @@ namespace scn {
                 format_options = 0;
 
                 int custom_base = 0;
+                bool thsep_set = false;
                 auto each = [&](ParseCtx& p, bool& parsed) -> error {
                     parsed = false;
                     auto ch = pctx.next_char();
 
+                    if (ch == detail::ascii_widen<char_type>('\'')) {
+                        parsed = true;
+                        return parse_thsep_flag(p, thsep_set, thsep_char);
+                    }
+
                     if (ch == detail::ascii_widen<char_type>('B')) {
                         // Custom base
                         p.advance_char();
@@ -112,7 +166,7 @@ namespace scn {
                     return {};
                 };
 
-                array<char_type, 9> options{{// decimal
+                array<char_type, 8> options{{// decimal
                                              ascii_widen<char_type>('d'),
                                              // binary
                                              ascii_widen<char_type>('b'),
@@ -127,14 +181,12 @@ namespace scn {
                                              // code unit
                                              ascii_widen<char_type>('c'),
                                              // localized digits
-                                             ascii_widen<char_type>('n'),
-                                             // thsep
-                                             ascii_widen<char_type>('\'')}};
-                bool flags[9] = {false};
+                                             ascii_widen<char_type>('n')}};
+                bool flags[8] = {false};
 
                 auto e = parse_common(
                     pctx, span<const char_type>{options.begin(), options.end()},
-                    span<bool>{flags, 9}, each);
+                    span<bool>{flags, 8}, each);
                 if (!e) {
                     return e;
                 }
@@ -205,7 +257,7 @@ namespace scn {
                 }
 
                 // thsep flag
-                if (flags[8]) {
+                if (thsep_set) {
                     format_options |= allow_thsep;
                 }
 
@@ -241,7 +293,7 @@ namespace scn {
                         }
                         if (b == -1) {
                             // -1 means we read a '0'
-                            tmp = 0;
+                            val = 0;
                             return {};
                         }
                         if (b != 10 && base != b && base != 0) {
@@ -257,22 +309,30 @@ namespace scn {
                                     "8, 10 or 16"};
                         }
 
-                        auto it = r.value();
-                        std::basic_string<char_type> str(to_address(it),
-                                                         s.size());
-                        ret = ctx.locale().get_localized().read_num(
-                            tmp, str, static_cast<int>(base));
-
-                        if (tmp < T{0} &&
-                            (format_options & only_unsigned) != 0) {
-                            return {error::invalid_scanned_value,
-                                    "Parsed negative value when type was 'u'"};
+                        const auto& loc = ctx.locale().get_localized();
+                        auto n = _parse_int_localized(
+                            tmp, make_span(r.value(), s.end()),
+                            loc.thousands_separator(), loc.grouping());
+                        if (!n) {
+                            return n.error();
                         }
+                        ret = ranges::distance(s.begin(), r.value()) +
+                              n.value();
                         SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     }
                     else {
+                        auto sep = char_type{};
+                        if (SCN_UNLIKELY((format_options & allow_thsep) !=
+                                         0)) {
+                            sep = thsep_char != 0
+                                      ? static_cast<char_type>(thsep_char)
+                                      : ctx.locale()
+                                            .get((common_options &
+                                                  localized) != 0)
+                                            .thousands_separator();
+                        }
                         SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                        ret = _parse_int(tmp, s);
+                        ret = _parse_int(tmp, s, sep);
                         SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     }
 
@@ -356,6 +416,10 @@ namespace scn {
             // Otherwise [2,36]
             uint8_t base{0};
 
+            // "'" option: digit group separator,
+            // 0 = thousands separator of the locale
+            char32_t thsep_char{0};
+
         private:
             static SCN_CONSTEXPR14 uint8_t default_format_options()
             {
@@ -375,69 +439,25 @@ namespace scn {
                                span<const CharT>& s,
                                std::false_type)
             {
-                auto do_read = [&](Buf& b) -> error {
-                    auto outputit = std::back_inserter(b);
-                    auto is_space_pred = make_is_space_predicate(
-                        ctx.locale(), (common_options & localized) != 0,
-                        field_width);
-                    auto e = read_until_space(ctx.range(), outputit,
-                                              is_space_pred, false);
-                    if (!e && b.empty()) {
-                        return e;
-                    }
-
-                    return {};
-                };
-
-                if (SCN_LIKELY((format_options & allow_thsep) == 0)) {
-                    auto e = do_read(buf);
-                    if (!e) {
-                        return e;
-                    }
-                    s = make_span(buf.data(), buf.size());
-                    return {};
-                }
-
-                Buf tmp;
-                auto e = do_read(tmp);
-                if (!e) {
+                auto outputit = std::back_inserter(buf);
+                auto is_space_pred = make_is_space_predicate(
+                    ctx.locale(), (common_options & localized) != 0,
+                    field_width);
+                auto e = read_until_space(ctx.range(), outputit, is_space_pred,
+                                          false);
+                if (!e && buf.empty()) {
                     return e;
                 }
-                auto thsep = ctx.locale()
-                                 .get((common_options & localized) != 0)
-                                 .thousands_separator();
-
-                auto it = tmp.begin();
-                for (; it != tmp.end(); ++it) {
-                    if (*it == thsep) {
-                        for (auto it2 = it; ++it2 != tmp.end();) {
-                            *it++ = SCN_MOVE(*it2);
-                        }
-                        break;
-                    }
-                }
-
-                auto n =
-                    static_cast<std::size_t>(std::distance(tmp.begin(), it));
-                if (n == 0) {
-                    return {error::invalid_scanned_value,
-                            "Only a thousands separator found"};
-                }
-
-                buf = SCN_MOVE(tmp);
-                s = make_span(buf.data(), n);
+                s = make_span(buf.data(), buf.size());
                 return {};
             }
 
             template <typename Context, typename Buf, typename CharT>
             error _read_source(Context& ctx,
-                               Buf& buf,
+                               Buf&,
                                span<const CharT>& s,
                                std::true_type)
             {
-                if (SCN_UNLIKELY((format_options & allow_thsep) != 0)) {
-                    return _read_source(ctx, buf, s, std::false_type{});
-                }
                 auto ret = read_zero_copy(
                     ctx.range(), field_width != 0
                                      ? static_cast<std::ptrdiff_t>(field_width)
@@ -454,14 +474,32 @@ namespace scn {
                 span<const CharT> s,
                 int& b) const;
 
+            // thsep != 0 and "'": digits may be separated by thsep
             template <typename CharT>
-            expected<std::ptrdiff_t> _parse_int(T& val, span<const CharT> s);
+            expected<std::ptrdiff_t> _parse_int(T& val,
+                                                span<const CharT> s,
+                                                CharT thsep = CharT{});
 
             template <typename CharT>
             expected<typename span<const CharT>::iterator> _parse_int_impl(
                 T& val,
                 bool minus_sign,
                 span<const CharT> buf) const;
+
+            template <typename CharT>
+            expected<typename span<const CharT>::iterator> _parse_int_grouped(
+                T& val,
+                bool minus_sign,
+                span<const CharT> buf,
+                CharT thsep) const;
+
+            // 'n': digits grouped with thsep according to grouping
+            template <typename CharT>
+            expected<std::ptrdiff_t> _parse_int_localized(
+                T& val,
+                span<const CharT> s,
+                CharT thsep,
+                string_view grouping) const;
         };
 
         // instantiate
@@ -475,6 +513,10 @@ namespace scn {
         template struct integer_scanner<unsigned int>;
         template struct integer_scanner<unsigned long>;
         template struct integer_scanner<unsigned long long>;
+#if SCN_HAS_INT128
+        template struct integer_scanner<int128>;
+        template struct integer_scanner<uint128>;
+#endif
         template struct integer_scanner<char>;
         template struct integer_scanner<wchar_t>;
 
@@ -19,6 +19,7 @@
 #define SCN_READER_READER_H
 
 #include "common.h"
+#include "decimal.h"
 #include "float.h"
 #include "int.h"
 #include "string.h"
@@ -76,6 +77,16 @@ namespace scn {
     struct scanner<unsigned long long>
         : public detail::integer_scanner<unsigned long long> {
     };
+#if SCN_HAS_INT128
+    template <>
+    struct scanner<detail::int128>
+        : public detail::integer_scanner<detail::int128> {
+    };
+    template <>
+    struct scanner<detail::uint128>
+        : public detail::integer_scanner<detail::uint128> {
+    };
+#endif
     template <>
     struct scanner<float> : public detail::float_scanner<float> {
     };
@@ -18,6 +18,7 @@
 #ifndef SCN_SCAN_LIST_H
 #define SCN_SCAN_LIST_H
 
+#include "../reader/int.h"
 #include "common.h"
 
 namespace scn {
@@ -444,6 +445,142 @@ namespace scn {
     }
 #endif
 
+    /**
+     * Base of the type returned by `scan_integers()`: the error, if any,
+     * and the number of integers written into the output buffer,
+     * which is also set if an error occurred.
+     */
+    struct scan_integers_count : public wrapped_error {
+        scan_integers_count() = default;
+        scan_integers_count(std::size_t n, ::scn::error e = {})
+            : wrapped_error(e), count(n)
+        {
+        }
+
+        /// Number of integers written, also set on failure
+        SCN_NODISCARD std::size_t value() const noexcept
+        {
+            return count;
+        }
+
+        std::size_t count{0};
+    };
+
+    namespace detail {
+        template <typename T, typename CharT>
+        scan_integers_count scan_integers_impl(const CharT*& it,
+                                                 const CharT* end,
+                                                 span<T> out,
+                                                 CharT separator)
+        {
+            auto skip_space = [&]() {
+                while (it != end && is_space(*it)) {
+                    ++it;
+                }
+            };
+
+            std::size_t n = 0;
+            skip_space();
+            while (n < out.size() && it != end) {
+                const auto elem_begin = it;
+                auto p = it;
+                if (*p == ascii_widen<CharT>('+')) {
+                    ++p;
+                }
+                if (p == end || (*p == ascii_widen<CharT>('-') &&
+                                 (!int_traits<T>::is_signed || p != it))) {
+                    break;
+                }
+
+                T val{};
+                SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                auto ret = simple_integer_scanner<T>::scan_lower(
+                    span<const CharT>(p, end), val, 10);
+                SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+                if (!ret) {
+                    it = elem_begin;
+                    return {n, ret.error()};
+                }
+                const auto digits_begin =
+                    *p == ascii_widen<CharT>('-') ? p + 1 : p;
+                if (ret.value() == digits_begin) {
+                    // Not an integer: stop before it
+                    break;
+                }
+                out[n++] = val;
+                it = ret.value();
+
+                skip_space();
+                if (separator != CharT{0} && it != end && *it == separator) {
+                    ++it;
+                    skip_space();
+                }
+            }
+            return n;
+        }
+    }  // namespace detail
+
+    /**
+     * Reads base-10 integers of type `T` from the contiguous range `r`
+     * directly into `out`, without going through the format string
+     * machinery for every value like `scan_list` does.
+     *
+     * The integers are separated by whitespace, and optionally by a single
+     * `separator` character (surrounded by any amount of whitespace).
+     * Reading stops when `out` is full, at the end of the range, or at
+     * the first character that doesn't start an integer.
+     *
+     * Returns the number of integers written into `out` with `value()`.
+     * If an integer is out of range for `T`, `error::value_out_of_range`
+     * is returned, and the range starts at that integer. `value()` is then
+     * the number of integers written before it.
+     *
+     * \code{.cpp}
+     * int buf[8];
+     * auto ret = scn::scan_integers("1, 2, 3 x", scn::make_span(buf, 8), ',');
+     * // ret.value() == 3
+     * // buf[0] == 1, buf[1] == 2, buf[2] == 3
+     * // ret.range_as_string() == "x"
+     *
+     * ret = scn::scan_integers("1 2 99999999999 4", scn::make_span(buf, 8));
+     * // ret.error() == scn::error::value_out_of_range
+     * // ret.value() == 2
+     * // ret.range_as_string() == "99999999999 4"
+     * \endcode
+     */
+#if SCN_DOXYGEN
+    template <typename T, typename Range, typename CharT>
+    auto scan_integers(Range&& r, span<T> out, CharT separator = 0)
+        -> detail::generic_scan_result_for_range<scan_integers_count, Range>;
+#else
+    template <typename T, typename Range, typename CharT>
+    SCN_NODISCARD auto scan_integers(Range&& r, span<T> out, CharT separator)
+        -> detail::generic_scan_result_for_range<scan_integers_count, Range>
+    {
+        auto range = wrap(SCN_FWD(r));
+        using char_type = typename decltype(range)::char_type;
+        static_assert(decltype(range)::is_contiguous,
+                      "scan_integers requires a contiguous range");
+        static_assert(std::is_same<char_type, CharT>::value,
+                      "The separator must be of the range's character type");
+
+        const char_type* begin = range.data();
+        const char_type* it = begin;
+        auto ret = detail::scan_integers_impl(it, begin + range.size(), out,
+                                              separator);
+        range.advance(it - begin);
+        return detail::wrap_result(SCN_MOVE(ret), detail::range_tag<Range>{},
+                                   SCN_MOVE(range));
+    }
+    template <typename T, typename Range>
+    SCN_NODISCARD auto scan_integers(Range&& r, span<T> out)
+        -> detail::generic_scan_result_for_range<scan_integers_count, Range>
+    {
+        using char_type = typename decltype(wrap(SCN_FWD(r)))::char_type;
+        return scan_integers(SCN_FWD(r), out, char_type{0});
+    }
+#endif
+
     SCN_END_NAMESPACE
 }  // namespace scn
 
@@ -0,0 +1,350 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_SCAN_PARALLEL_H
+#define SCN_SCAN_PARALLEL_H
+
+#include "list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if SCN_HAS_EXCEPTIONS
+#include <exception>
+#include <mutex>
+#include <system_error>
+#endif
+
+namespace scn {
+    SCN_BEGIN_NAMESPACE
+
+    /**
+     * Used to customize `scan_parallel()` and `scan_list_parallel()`.
+     *
+     * \tparam CharT Character type of the source range
+     */
+    template <typename CharT>
+    struct scan_parallel_options {
+        /**
+         * Records are never split between shards:
+         * the input is only cut right after this character.
+         */
+        CharT delimiter{static_cast<CharT>('\n')};
+        /**
+         * Maximum number of threads to use, including the calling thread.
+         * If 0, `std::thread::hardware_concurrency()` is used.
+         */
+        unsigned threads{0};
+        /**
+         * Shards smaller than this are not created:
+         * small inputs are scanned with fewer threads, or on the calling
+         * thread only.
+         */
+        std::size_t min_shard_size{64 * 1024};
+
+        scan_parallel_options() = default;
+        scan_parallel_options(CharT d,
+                              unsigned t = 0,
+                              std::size_t min_size = 64 * 1024)
+            : delimiter(d), threads(t), min_shard_size(min_size)
+        {
+        }
+    };
+
+    namespace detail {
+        template <typename Range>
+        using parallel_char_type =
+            typename range_wrapper_for_t<const Range&>::char_type;
+
+        template <typename Function, typename CharT>
+        using parallel_result_type = typename std::decay<decltype(
+            SCN_DECLVAL(Function&)(SCN_DECLVAL(basic_string_view<CharT>)))>::
+            type;
+
+        template <typename Range>
+        auto parallel_source(const Range& r)
+            -> basic_string_view<parallel_char_type<Range>>
+        {
+            auto wrapped = wrap(r);
+            static_assert(decltype(wrapped)::is_contiguous,
+                          "scan_parallel requires a contiguous range");
+            if (wrapped.empty()) {
+                return {};
+            }
+            return {wrapped.data(), static_cast<std::size_t>(wrapped.size())};
+        }
+
+        /**
+         * Cut `source` into at most `count` shards of roughly equal size,
+         * ending right after a `delimiter`, or at the end of `source`.
+         */
+        template <typename CharT>
+        std::vector<basic_string_view<CharT>> split_shards(
+            basic_string_view<CharT> source,
+            CharT delimiter,
+            std::size_t count,
+            std::size_t min_size)
+        {
+            std::vector<basic_string_view<CharT>> shards;
+            if (source.empty()) {
+                return shards;
+            }
+
+            count = (std::min)(count,
+                               source.size() / (std::max)(min_size, size_t{1}));
+            count = (std::max)(count, size_t{1});
+            const auto approx = source.size() / count;
+            shards.reserve(count);
+
+            std::size_t begin = 0;
+            while (begin < source.size()) {
+                auto end = source.size();
+                if (shards.size() + 1 < count &&
+                    begin + approx < source.size()) {
+                    auto it = std::find(source.begin() + begin + approx,
+                                        source.end(), delimiter);
+                    if (it != source.end()) {
+                        end = static_cast<std::size_t>(it - source.begin()) + 1;
+                    }
+                }
+                shards.emplace_back(source.data() + begin, end - begin);
+                begin = end;
+            }
+            return shards;
+        }
+
+        /**
+         * Call `f(i)` for every `i` in `[0, n)`, on up to `threads` threads,
+         * one of them being the calling thread.
+         * The first exception thrown by `f` is rethrown, after all threads
+         * have finished.
+         */
+        template <typename Function>
+        void parallel_for_index(std::size_t n, unsigned threads, Function& f)
+        {
+            if (n == 0) {
+                return;
+            }
+            std::atomic<std::size_t> next{0};
+#if SCN_HAS_EXCEPTIONS
+            std::exception_ptr exception{};
+            std::mutex exception_mutex{};
+#endif
+
+            auto worker = [&]() {
+                std::size_t i;
+                while ((i = next.fetch_add(1)) < n) {
+#if SCN_HAS_EXCEPTIONS
+                    try {
+                        f(i);
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock{exception_mutex};
+                        if (!exception) {
+                            exception = std::current_exception();
+                        }
+                        // stop handing out more work
+                        next.store(n);
+                    }
+#else
+                    f(i);
+#endif
+                }
+            };
+
+            std::vector<std::thread> pool;
+            const auto extra =
+                (std::min)(static_cast<std::size_t>(threads), n) - 1;
+            pool.reserve(extra);
+            for (std::size_t t = 0; t < extra; ++t) {
+#if SCN_HAS_EXCEPTIONS
+                try {
+                    pool.emplace_back(worker);
+                }
+                catch (const std::system_error&) {
+                    // Can't create more threads:
+                    // do with the ones we already have
+                    break;
+                }
+#else
+                pool.emplace_back(worker);
+#endif
+            }
+            worker();
+            for (auto& t : pool) {
+                t.join();
+            }
+
+#if SCN_HAS_EXCEPTIONS
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+#endif
+        }
+    }  // namespace detail
+
+    /**
+     * Splits the contiguous range `r` into shards, and calls `f` with every
+     * shard (as a `basic_string_view`) on a pool of threads.
+     * The shards are cut right after `options.delimiter`,
+     * so that no record is split between two shards.
+     *
+     * Returns the return values of `f`, in the order of the shards in `r`.
+     * Returns an empty `std::vector`, if `r` is empty.
+     *
+     * `f` is called concurrently from multiple threads.
+     * If `f` throws, the exception is rethrown from `scan_parallel`,
+     * after all of the threads have finished.
+     *
+     * \code{.cpp}
+     * auto file = scn::mapped_file{"data.csv"};
+     * // sum the second column of every line
+     * auto sums = scn::scan_parallel(file, [](scn::string_view shard) {
+     *     long long sum = 0;
+     *     auto result = scn::make_result(shard);
+     *     int a, b;
+     *     while ((result = scn::scan(result.range(), "{},{}", a, b))) {
+     *         sum += b;
+     *     }
+     *     return sum;
+     * });
+     * auto total = std::accumulate(sums.begin(), sums.end(), 0LL);
+     * \endcode
+     *
+     * \param r Range to scan from, must be contiguous
+     * (e.g. a `basic_mapped_file`, or a string)
+     * \param f Function to call with every shard
+     * \param options Options to use
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename Function, typename CharT>
+    auto scan_parallel(const Range& r,
+                       Function f,
+                       scan_parallel_options<CharT> options = {})
+        -> std::vector<detail::parallel_result_type<Function, CharT>>;
+#else
+    template <typename Range,
+              typename Function,
+              typename CharT = detail::parallel_char_type<Range>>
+    SCN_NODISCARD auto scan_parallel(const Range& r,
+                                     Function f,
+                                     scan_parallel_options<CharT> options = {})
+        -> std::vector<detail::parallel_result_type<Function, CharT>>
+    {
+        static_assert(
+            std::is_same<CharT, detail::parallel_char_type<Range>>::value,
+            "scan_parallel_options<CharT>: CharT must match the character "
+            "type of the source range");
+        using result_type = detail::parallel_result_type<Function, CharT>;
+
+        auto threads = options.threads;
+        if (threads == 0) {
+            threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+        }
+        // Make more shards than there are threads,
+        // so that threads finishing early can pick up the slack
+        auto shards = detail::split_shards(
+            detail::parallel_source(r), options.delimiter,
+            static_cast<std::size_t>(threads) * 4, options.min_shard_size);
+
+        std::vector<optional<result_type>> results(shards.size());
+        auto call = [&](std::size_t i) { results[i] = f(shards[i]); };
+        detail::parallel_for_index(shards.size(), threads, call);
+
+        std::vector<result_type> ret;
+        ret.reserve(results.size());
+        for (auto& res : results) {
+            ret.push_back(SCN_MOVE(res.get()));
+        }
+        return ret;
+    }
+#endif
+
+    /**
+     * Parallel equivalent of `scan_list_ex()`: scans the shards of `r` on
+     * multiple threads (see `scan_parallel()`), and writes the values
+     * read into `c`, in the order they were in `r`.
+     *
+     * Values are separated by whitespace, or by `options.delimiter`.
+     *
+     * If an invalid value is scanned, that error is returned.
+     * The values preceding the invalid one will be in `c`.
+     *
+     * \code{.cpp}
+     * std::vector<int> vec{};
+     * auto file = scn::mapped_file{"numbers.txt"};
+     * auto err = scn::scan_list_parallel(file, vec);
+     * \endcode
+     *
+     * \param r Range to scan from, must be contiguous
+     * \param c Container to write values to, using `c.push_back()`
+     * \param options Options to use
+     */
+#if SCN_DOXYGEN
+    template <typename Range, typename Container, typename CharT>
+    error scan_list_parallel(const Range& r,
+                             Container& c,
+                             scan_parallel_options<CharT> options = {});
+#else
+    template <typename Range,
+              typename Container,
+              typename CharT = detail::parallel_char_type<Range>>
+    SCN_NODISCARD error
+    scan_list_parallel(const Range& r,
+                       Container& c,
+                       scan_parallel_options<CharT> options = {})
+    {
+        using value_type = typename Container::value_type;
+        struct shard_result {
+            std::vector<value_type> values{};
+            error err{};
+        };
+
+        auto results = scan_parallel(
+            r,
+            [&](basic_string_view<CharT> shard) -> shard_result {
+                shard_result res{};
+                auto ret = scan_list_ex(shard, res.values,
+                                        list_separator(options.delimiter));
+                if (!ret) {
+                    res.err = ret.error();
+                }
+                return res;
+            },
+            options);
+
+        for (auto& res : results) {
+            for (auto& val : res.values) {
+                if (c.size() == c.max_size()) {
+                    return {};
+                }
+                c.push_back(SCN_MOVE(val));
+            }
+            if (!res.err) {
+                return res.err;
+            }
+        }
+        return {};
+    }
+#endif
+
+    SCN_END_NAMESPACE
+}  // namespace scn
+
+#endif  // SCN_SCAN_PARALLEL_H
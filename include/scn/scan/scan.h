@@ -265,6 +265,17 @@ namespace scn {
      * Otherwise equivalent to \ref scan, expect reads from `stdin`.
      * Character type is determined by the format string.
      * Syncs with `<cstdio>`.
+     *
+     * If scanning fails, the characters read by it are discarded, and not
+     * put back into `stdin`, so that a retry loop doesn't fail on the same
+     * input forever:
+     *
+     * \code{.cpp}
+     * int i;
+     * while (!scn::input("{}", i)) {
+     *     std::puts("Not a number, try again");
+     * }
+     * \endcode
      */
     template <typename Format,
               typename... Args,
@@ -278,6 +289,9 @@ namespace scn {
     {
         auto& range = stdin_range<CharT>();
         auto ret = detail::scan_boilerplate(range, f, a...);
+        if (!ret) {
+            detail::basic_file_access<CharT>::consume_buffer(range);
+        }
         range.sync();
         ret.range().reset_begin_iterator();
         return ret;
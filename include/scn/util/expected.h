@@ -47,7 +47,7 @@ namespace scn {
         using error_type = Error;
 
         constexpr expected() = default;
-        constexpr expected(success_type s) : m_s(s) {}
+        constexpr expected(success_type s) : m_s(SCN_MOVE(s)) {}
         constexpr expected(error_type e) : m_e(e) {}
 
         SCN_NODISCARD constexpr bool has_value() const noexcept
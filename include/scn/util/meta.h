@@ -36,6 +36,12 @@ namespace scn {
         template <typename... T>
         void valid_expr(T&&...);
 
+#if SCN_HAS_INT128
+        // __extension__: no -Wpedantic warnings for using the typedefs
+        __extension__ typedef __int128 int128;
+        __extension__ typedef unsigned __int128 uint128;
+#endif
+
         template <typename T>
         struct remove_cvref {
             using type = typename std::remove_cv<
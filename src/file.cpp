@@ -23,7 +23,20 @@
 #include <scn/detail/file.h>
 #include <scn/util/expected.h>
 
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
 #include <cstdio>
+#include <cwchar>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if SCN_HAS_EXCEPTIONS
+#include <system_error>
+#endif
 
 #if SCN_POSIX
 #include <fcntl.h>
@@ -32,6 +45,18 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+// Not SCN_HAS_INCLUDE: GCC doesn't expand __has_include inside of a macro
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define SCN_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
 #elif SCN_WINDOWS
 
 #ifdef WIN32_LEAN_AND_MEAN
@@ -49,6 +74,7 @@
 #endif
 
 #include <Windows.h>
+#include <io.h>
 
 #if !SCN_NOMINMAX_DEFINED
 #undef NOMINMAX
@@ -60,6 +86,10 @@
 
 #endif
 
+#ifndef SCN_HAS_IO_URING
+#define SCN_HAS_IO_URING 0
+#endif
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -73,89 +103,1342 @@ namespace scn {
 #endif
         }
 
-        SCN_FUNC byte_mapped_file::byte_mapped_file(const char* filename)
+        SCN_FUNC byte_mapped_file::byte_mapped_file(const char* filename,
+                                                     map_hint hints)
+        {
+            // Errors are reported with valid() only
+            auto e = _open(filename, 0, 0, hints);
+            SCN_UNUSED(e);
+        }
+
+#if SCN_POSIX
+        static error errno_to_error(int e)
+        {
+            switch (e) {
+                case ENOENT:
+                    return {error::source_error,
+                            "No such file or directory (ENOENT)"};
+                case EACCES:
+                    return {error::source_error, "Permission denied (EACCES)"};
+                case EPERM:
+                    return {error::source_error,
+                            "Operation not permitted (EPERM)"};
+                case EISDIR:
+                    return {error::source_error, "Is a directory (EISDIR)"};
+                case ENOTDIR:
+                    return {error::source_error, "Not a directory (ENOTDIR)"};
+                case ENAMETOOLONG:
+                    return {error::source_error,
+                            "File name too long (ENAMETOOLONG)"};
+                case ELOOP:
+                    return {error::source_error,
+                            "Too many levels of symbolic links (ELOOP)"};
+                case EMFILE:
+                    return {error::source_error,
+                            "Too many open files (EMFILE)"};
+                case ENFILE:
+                    return {error::source_error,
+                            "Too many open files in system (ENFILE)"};
+                case EBADF:
+                    return {error::invalid_argument,
+                            "Bad file descriptor (EBADF)"};
+                case EINVAL:
+                    return {error::invalid_argument,
+                            "Invalid argument (EINVAL)"};
+                case EOVERFLOW:
+                    return {error::invalid_argument,
+                            "Value too large (EOVERFLOW)"};
+                case ENODEV:
+                    return {error::invalid_operation,
+                            "File can't be memory mapped (ENODEV)"};
+                case ENOMEM:
+                    return {error::source_error, "Out of memory (ENOMEM)"};
+                default:
+                    return {error::source_error, "Unknown error"};
+            }
+        }
+#endif
+
+        SCN_FUNC error byte_mapped_file::_open(const char* filename,
+                                               size_t offset,
+                                               size_t length,
+                                               map_hint hints)
         {
 #if SCN_POSIX
-            int fd = open(filename, O_RDONLY);
+            int fd = ::open(filename, O_RDONLY);
             if (fd == -1) {
-                return;
+                return errno_to_error(errno);
+            }
+            return _map({fd}, offset, length, hints);
+#elif SCN_WINDOWS
+            auto f = ::CreateFileA(
+                filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (f == INVALID_HANDLE_VALUE) {
+                return {error::source_error, "CreateFileA failed"};
             }
+            return _map({f}, offset, length, hints);
+#else
+            SCN_UNUSED(filename);
+            SCN_UNUSED(offset);
+            SCN_UNUSED(length);
+            SCN_UNUSED(hints);
+            return {error::invalid_operation,
+                    "Mapping files is not supported"};
+#endif
+        }
 
-            struct stat s {
+        SCN_FUNC error byte_mapped_file::_map(native_file_handle file,
+                                              size_t offset,
+                                              size_t length,
+                                              map_hint hints)
+        {
+            SCN_EXPECT(!valid());
+#if SCN_POSIX
+            const int fd = file.handle;
+            // Close fd, but keep errno intact, so that it can be inspected
+            // by the caller
+            auto fail = [&](error e) {
+                const auto saved = errno;
+                ::close(fd);
+                errno = saved;
+                return e;
             };
-            int status = fstat(fd, &s);
-            if (status == -1) {
-                close(fd);
-                return;
+
+            {
+                // Pages past the end of the file can't be accessed (SIGBUS):
+                // clamp the length to the size of the file
+                struct stat s {
+                };
+                if (fstat(fd, &s) == -1) {
+                    return fail(errno_to_error(errno));
+                }
+                const auto size = static_cast<size_t>(s.st_size);
+                if (offset > size) {
+                    errno = EINVAL;
+                    return fail({error::invalid_argument,
+                                 "Offset is past the end of the file"});
+                }
+                if (length == 0 || length > size - offset) {
+                    length = size - offset;
+                }
+            }
+
+            m_file.handle = fd;
+            if (length == 0) {
+                // Nothing to map
+                return {};
             }
-            auto size = s.st_size;
 
-            auto ptr =
-                static_cast<char*>(mmap(nullptr, static_cast<size_t>(size),
-                                        PROT_READ, MAP_PRIVATE, fd, 0));
+            // mmap requires the offset to be page-aligned
+            static const auto page_size =
+                static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const auto page_offset = offset % page_size;
+
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (hints & map_hint::populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            auto ptr = static_cast<char*>(
+                mmap(nullptr, length + page_offset, PROT_READ, flags, fd,
+                     static_cast<off_t>(offset - page_offset)));
             if (ptr == MAP_FAILED) {
-                close(fd);
+                m_file = native_file_handle::invalid();
+                return fail(errno_to_error(errno));
+            }
+
+            // Hints are only advisory: errors are ignored
+            if (hints & map_hint::sequential) {
+                madvise(ptr, length + page_offset, MADV_SEQUENTIAL);
+            }
+            if (hints & map_hint::willneed) {
+                madvise(ptr, length + page_offset, MADV_WILLNEED);
+            }
+#ifdef MADV_HUGEPAGE
+            if (hints & map_hint::huge_pages) {
+                madvise(ptr, length + page_offset, MADV_HUGEPAGE);
+            }
+#endif
+
+            m_map = span<char>{ptr + page_offset, length};
+            m_page_offset = page_offset;
+            return {};
+#elif SCN_WINDOWS
+            SCN_UNUSED(hints);
+            auto f = file.handle;
+
+            {
+                LARGE_INTEGER _size;
+                if (::GetFileSizeEx(f, &_size) == 0) {
+                    ::CloseHandle(f);
+                    return {error::source_error, "GetFileSizeEx failed"};
+                }
+                const auto size = static_cast<size_t>(_size.QuadPart);
+                if (offset > size) {
+                    ::CloseHandle(f);
+                    return {error::invalid_argument,
+                            "Offset is past the end of the file"};
+                }
+                if (length == 0 || length > size - offset) {
+                    length = size - offset;
+                }
+            }
+
+            m_file.handle = f;
+            if (length == 0) {
+                // Nothing to map
+                return {};
+            }
+
+            auto h = ::CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0,
+                                          nullptr);
+            if (h == INVALID_HANDLE_VALUE || h == nullptr) {
+                m_file = native_file_handle::invalid();
+                ::CloseHandle(f);
+                return {error::source_error, "CreateFileMappingA failed"};
+            }
+
+            // Views need to start at a multiple of the allocation granularity
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            const auto page_offset =
+                offset % static_cast<size_t>(info.dwAllocationGranularity);
+            const auto off =
+                static_cast<unsigned long long>(offset - page_offset);
+
+            auto start = ::MapViewOfFile(
+                h, FILE_MAP_READ, static_cast<DWORD>(off >> 32ull),
+                static_cast<DWORD>(off & 0xffffffffull), length + page_offset);
+            if (!start) {
+                m_file = native_file_handle::invalid();
+                ::CloseHandle(h);
+                ::CloseHandle(f);
+                return {error::source_error, "MapViewOfFile failed"};
+            }
+
+            m_map_handle.handle = h;
+            m_map = span<char>{static_cast<char*>(start) + page_offset, length};
+            m_page_offset = page_offset;
+            return {};
+#else
+            SCN_UNUSED(file);
+            SCN_UNUSED(offset);
+            SCN_UNUSED(length);
+            SCN_UNUSED(hints);
+            return {error::invalid_operation,
+                    "Mapping files is not supported"};
+#endif
+        }
+
+        SCN_FUNC error byte_mapped_file::_map_handle(
+            native_file_handle::handle_type handle,
+            size_t offset,
+            size_t length,
+            map_hint hints)
+        {
+            // Duplicate the handle, so that the caller keeps the ownership
+            // of the original
+#if SCN_POSIX
+            int fd = ::dup(handle);
+            if (fd == -1) {
+                return errno_to_error(errno);
+            }
+            return _map({fd}, offset, length, hints);
+#elif SCN_WINDOWS
+            HANDLE h = nullptr;
+            if (::DuplicateHandle(::GetCurrentProcess(), handle,
+                                  ::GetCurrentProcess(), &h, 0, FALSE,
+                                  DUPLICATE_SAME_ACCESS) == 0) {
+                return {error::invalid_argument, "DuplicateHandle failed"};
+            }
+            return _map({h}, offset, length, hints);
+#else
+            SCN_UNUSED(handle);
+            SCN_UNUSED(offset);
+            SCN_UNUSED(length);
+            SCN_UNUSED(hints);
+            return {error::invalid_operation,
+                    "Mapping files is not supported"};
+#endif
+        }
+
+        SCN_FUNC void byte_mapped_file::_destruct()
+        {
+#if SCN_POSIX
+            if (m_map.size() != 0) {
+                munmap(m_map.data() - m_page_offset,
+                       m_map.size() + m_page_offset);
+            }
+            close(m_file.handle);
+#elif SCN_WINDOWS
+            if (m_map.size() != 0) {
+                ::UnmapViewOfFile(m_map.data() - m_page_offset);
+                ::CloseHandle(m_map_handle.handle);
+            }
+            ::CloseHandle(m_file.handle);
+            m_map_handle = native_file_handle::invalid();
+#endif
+
+            m_file = native_file_handle::invalid();
+            m_map = span<char>{};
+            m_page_offset = 0;
+            m_released = 0;
+
+            SCN_ENSURE(!valid());
+        }
+
+        SCN_FUNC void byte_mapped_file::_release(size_t n) noexcept
+        {
+            SCN_EXPECT(n <= m_map.size());
+#if SCN_POSIX
+            static const auto page_size =
+                static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            // the mapping itself is page-aligned,
+            // m_map starts m_page_offset bytes into it
+            n += m_page_offset;
+            const auto end = n - n % page_size;
+            if (end <= m_released) {
                 return;
             }
+            madvise(m_map.data() - m_page_offset + m_released,
+                    end - m_released, MADV_DONTNEED);
+            m_released = end;
+#else
+            SCN_UNUSED(n);
+#endif
+        }
+
+        SCN_FUNC byte_windowed_mapped_file::byte_windowed_mapped_file(
+            const char* filename,
+            size_t window_size)
+        {
+            // Errors are reported with valid() only
+            auto e = _open(filename, window_size);
+            SCN_UNUSED(e);
+        }
+
+        SCN_FUNC error
+        byte_windowed_mapped_file::_open(const char* filename,
+                                         size_t window_size)
+        {
+            SCN_EXPECT(!valid());
+#if SCN_POSIX
+            const auto granularity =
+                static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+            int fd = ::open(filename, O_RDONLY);
+            if (fd == -1) {
+                return errno_to_error(errno);
+            }
+
+            struct stat s {
+            };
+            if (fstat(fd, &s) == -1) {
+                // Close fd, but keep errno intact
+                const auto saved = errno;
+                ::close(fd);
+                errno = saved;
+                return errno_to_error(saved);
+            }
 
             m_file.handle = fd;
-            m_map = span<char>{ptr, static_cast<size_t>(size)};
+            m_file_size = static_cast<size_t>(s.st_size);
 #elif SCN_WINDOWS
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            const auto granularity =
+                static_cast<size_t>(info.dwAllocationGranularity);
+
             auto f = ::CreateFileA(
                 filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
                 nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
             if (f == INVALID_HANDLE_VALUE) {
-                return;
+                return {error::source_error, "CreateFileA failed"};
             }
 
             LARGE_INTEGER _size;
             if (::GetFileSizeEx(f, &_size) == 0) {
                 ::CloseHandle(f);
-                return;
+                return {error::source_error, "GetFileSizeEx failed"};
+            }
+            const auto size = static_cast<size_t>(_size.QuadPart);
+
+            // Creating a mapping object doesn't reserve any address space,
+            // only the views do
+            HANDLE h = nullptr;
+            if (size != 0) {
+                h = ::CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0,
+                                         nullptr);
+                if (h == INVALID_HANDLE_VALUE || h == nullptr) {
+                    ::CloseHandle(f);
+                    return {error::source_error, "CreateFileMappingA failed"};
+                }
             }
-            auto size = static_cast<size_t>(_size.QuadPart);
 
-            auto h = ::CreateFileMappingA(
-                f, nullptr, PAGE_READONLY,
-#ifdef _WIN64
-                static_cast<DWORD>(size >> 32ull),
+            m_file.handle = f;
+            m_map_handle.handle = h;
+            m_file_size = size;
 #else
-                DWORD{0},
+            SCN_UNUSED(filename);
+            SCN_UNUSED(window_size);
+            return {error::invalid_operation,
+                    "Mapping files is not supported"};
 #endif
-                static_cast<DWORD>(size & 0xffffffffull), nullptr);
-            if (h == INVALID_HANDLE_VALUE || h == nullptr) {
-                ::CloseHandle(f);
-                return;
+#if SCN_POSIX || SCN_WINDOWS
+            m_window_size =
+                detail::max(granularity, (window_size + granularity - 1) /
+                                             granularity * granularity);
+            return {};
+#endif
+        }
+
+        SCN_FUNC error byte_windowed_mapped_file::_fill(size_t begin,
+                                                        size_t end) const
+        {
+            SCN_EXPECT(valid());
+            SCN_EXPECT(begin < end);
+            if (end > m_file_size) {
+                return {error::end_of_range, "EOF"};
+            }
+            if (begin >= m_offset && end <= m_offset + m_map.size()) {
+                return {};
             }
 
-            auto start = ::MapViewOfFile(h, FILE_MAP_READ, 0, 0, size);
-            if (!start) {
-                ::CloseHandle(h);
-                ::CloseHandle(f);
-                return;
+#if SCN_POSIX
+            const auto granularity =
+                static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif SCN_WINDOWS
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            const auto granularity =
+                static_cast<size_t>(info.dwAllocationGranularity);
+#else
+            const size_t granularity = 1;
+#endif
+
+            // Start the window from the rollback point, if it's close enough,
+            // so that a value straddling the previous window boundary can be
+            // rolled back without remapping
+            auto base = begin;
+            if (m_rollback <= begin && begin - m_rollback < m_window_size / 2) {
+                base = m_rollback;
             }
+            const auto offset = base - base % granularity;
+            const auto size = detail::min(
+                detail::max(m_window_size, end - offset), m_file_size - offset);
 
-            m_file.handle = f;
-            m_map_handle.handle = h;
-            m_map = span<char>{static_cast<char*>(start), size};
+            _unmap();
+#if SCN_POSIX
+            auto ptr = static_cast<char*>(mmap(nullptr, size, PROT_READ,
+                                               MAP_PRIVATE, m_file.handle,
+                                               static_cast<off_t>(offset)));
+            if (ptr == MAP_FAILED) {
+                return {error::source_error, "mmap failed"};
+            }
+#elif SCN_WINDOWS
+            const auto off = static_cast<unsigned long long>(offset);
+            auto ptr = static_cast<char*>(::MapViewOfFile(
+                m_map_handle.handle, FILE_MAP_READ,
+                static_cast<DWORD>(off >> 32ull),
+                static_cast<DWORD>(off & 0xffffffffull), size));
+            if (!ptr) {
+                return {error::source_error, "MapViewOfFile failed"};
+            }
+#endif
+#if SCN_POSIX || SCN_WINDOWS
+            m_map = span<char>{ptr, size};
+            m_offset = offset;
+            return {};
 #else
-            SCN_UNUSED(filename);
+            SCN_UNUSED(size);
+            SCN_UNUSED(offset);
+            return {error::source_error, "Mapping files is not supported"};
 #endif
         }
 
-        SCN_FUNC void byte_mapped_file::_destruct()
+        SCN_FUNC void byte_windowed_mapped_file::_unmap() const noexcept
         {
+            if (m_map.size() == 0) {
+                return;
+            }
 #if SCN_POSIX
             munmap(m_map.data(), m_map.size());
+#elif SCN_WINDOWS
+            ::UnmapViewOfFile(m_map.data());
+#endif
+            m_map = span<char>{};
+            m_offset = 0;
+        }
+
+        SCN_FUNC void byte_windowed_mapped_file::_destruct() noexcept
+        {
+            _unmap();
+#if SCN_POSIX
             close(m_file.handle);
 #elif SCN_WINDOWS
-            ::CloseHandle(m_map_handle.handle);
+            if (m_map_handle.handle) {
+                ::CloseHandle(m_map_handle.handle);
+            }
             ::CloseHandle(m_file.handle);
             m_map_handle = native_file_handle::invalid();
 #endif
-
             m_file = native_file_handle::invalid();
-            m_map = span<char>{};
+            m_file_size = 0;
+            m_rollback = 0;
+
+            SCN_ENSURE(!valid());
+        }
+
+        SCN_FUNC error byte_fd_file::_fill(size_t end) const
+        {
+            SCN_EXPECT(valid());
+            while (m_offset + m_size < end) {
+                auto e = _read_more();
+                if (!e) {
+                    return e;
+                }
+            }
+            return {};
+        }
+
+        SCN_FUNC void byte_fd_file::_prepare_append(size_t n) const
+        {
+            // Discard everything before the rollback point
+            SCN_EXPECT(m_rollback >= m_offset);
+            if (m_rollback != m_offset) {
+                const auto consumed = m_rollback - m_offset;
+                std::memmove(m_data.get(), m_data.get() + consumed,
+                             m_size - consumed);
+                m_size -= consumed;
+                m_offset = m_rollback;
+            }
+            // Grow the buffer, if there's not enough room left in it
+            if (m_capacity - m_size < n) {
+                const auto cap = detail::max(
+                    detail::max(m_buffer_size, m_capacity * 2), m_size + n);
+                std::unique_ptr<char[]> data{new char[cap]};
+                if (m_size != 0) {
+                    std::memcpy(data.get(), m_data.get(), m_size);
+                }
+                m_data = SCN_MOVE(data);
+                m_capacity = cap;
+            }
+        }
+
+        SCN_FUNC error byte_fd_file::_read_more() const
+        {
+            _prepare_append(1);
+
+            while (true) {
+#if SCN_POSIX
+                const auto n =
+                    ::read(m_fd, m_data.get() + m_size, m_capacity - m_size);
+#elif SCN_WINDOWS
+                const auto n = ::_read(
+                    m_fd, m_data.get() + m_size,
+                    static_cast<unsigned>(
+                        detail::min(m_capacity - m_size, size_t{0x7fffffff})));
+#else
+                const int n = -1;
+                errno = ENOSYS;
+#endif
+                if (n > 0) {
+                    m_size += static_cast<size_t>(n);
+                    return {};
+                }
+                if (n == 0) {
+                    return {error::end_of_range, "EOF"};
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                return {error::source_error, "read error"};
+            }
+        }
+
+        SCN_FUNC void byte_fd_file::_sync() noexcept
+        {
+            SCN_EXPECT(m_rollback >= m_offset);
+            const auto n = m_offset + m_size - m_rollback;
+            if (n != 0) {
+#if SCN_POSIX
+                const bool ok = ::lseek(m_fd, -static_cast<off_t>(n),
+                                        SEEK_CUR) != static_cast<off_t>(-1);
+#elif SCN_WINDOWS
+                const bool ok =
+                    ::_lseeki64(m_fd, -static_cast<__int64>(n), SEEK_CUR) != -1;
+#else
+                const bool ok = false;
+#endif
+                if (!ok) {
+                    // Not seekable: keep the bytes in the buffer
+                    return;
+                }
+            }
+            m_offset = m_rollback;
+            m_size = 0;
+        }
+
+        SCN_FUNC void byte_fd_file::_destruct() noexcept
+        {
+            if (m_owning) {
+#if SCN_POSIX
+                ::close(m_fd);
+#elif SCN_WINDOWS
+                ::_close(m_fd);
+#endif
+            }
+            else {
+                _sync();
+            }
+            m_fd = -1;
+            m_owning = false;
+            m_data.reset();
+            m_capacity = m_size = m_offset = m_rollback = 0;
+
+            SCN_ENSURE(!valid());
+        }
+
+#if SCN_HAS_IO_URING
+        // Using the raw system calls, to not depend on liburing
+        struct byte_uring_file::uring_state {
+            struct slot {
+                std::unique_ptr<char[]> data{};
+                struct iovec iov {
+                };
+                uint64_t offset{0};
+                int result{0};
+                bool in_flight{false};
+            };
+
+            uring_state() = default;
+            uring_state(const uring_state&) = delete;
+            uring_state& operator=(const uring_state&) = delete;
+            uring_state(uring_state&&) = delete;
+            uring_state& operator=(uring_state&&) = delete;
+
+            ~uring_state()
+            {
+                SCN_UNUSED(drain());
+                if (sqes != MAP_FAILED) {
+                    munmap(sqes, sqes_size);
+                }
+                if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+                    munmap(cq_ring, cq_ring_size);
+                }
+                if (sq_ring != MAP_FAILED) {
+                    munmap(sq_ring, sq_ring_size);
+                }
+                if (ring_fd != -1) {
+                    close(ring_fd);
+                }
+            }
+
+            // Returns nullptr, if io_uring can't be used
+            static std::unique_ptr<uring_state> create(int fd,
+                                                       size_t block_size,
+                                                       unsigned depth)
+            {
+                io_uring_params params{};
+                const auto ring_fd = static_cast<int>(
+                    syscall(__NR_io_uring_setup, depth, &params));
+                if (ring_fd < 0) {
+                    return {};
+                }
+
+                std::unique_ptr<uring_state> st{new uring_state{}};
+                st->ring_fd = ring_fd;
+                st->fd = fd;
+                st->block_size = block_size;
+
+                st->sq_ring_size =
+                    params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                st->cq_ring_size = params.cq_off.cqes +
+                                   params.cq_entries * sizeof(io_uring_cqe);
+                bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+                if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+                    single_mmap = true;
+                    st->sq_ring_size = st->cq_ring_size =
+                        detail::max(st->sq_ring_size, st->cq_ring_size);
+                }
+#endif
+                st->sq_ring = mmap(nullptr, st->sq_ring_size,
+                                   PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, ring_fd,
+                                   IORING_OFF_SQ_RING);
+                if (st->sq_ring == MAP_FAILED) {
+                    return {};
+                }
+                if (single_mmap) {
+                    st->cq_ring = st->sq_ring;
+                }
+                else {
+                    st->cq_ring = mmap(nullptr, st->cq_ring_size,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, ring_fd,
+                                       IORING_OFF_CQ_RING);
+                    if (st->cq_ring == MAP_FAILED) {
+                        return {};
+                    }
+                }
+                st->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+                st->sqes = mmap(nullptr, st->sqes_size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, ring_fd,
+                                IORING_OFF_SQES);
+                if (st->sqes == MAP_FAILED) {
+                    return {};
+                }
+
+                auto sq = static_cast<char*>(st->sq_ring);
+                st->sq_tail =
+                    reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                st->sq_mask =
+                    *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                st->sq_array =
+                    reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                auto cq = static_cast<char*>(st->cq_ring);
+                st->cq_head =
+                    reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                st->cq_tail =
+                    reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                st->cq_mask =
+                    *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                st->cqes =
+                    reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+                st->slots.resize(depth);
+                for (auto& sl : st->slots) {
+                    sl.data.reset(new char[block_size]);
+                }
+                return st;
+            }
+
+            error enter(unsigned min_complete, unsigned flags)
+            {
+                while (true) {
+                    const auto ret = syscall(__NR_io_uring_enter, ring_fd,
+                                             pending, min_complete, flags,
+                                             nullptr, 0);
+                    if (ret >= 0) {
+                        pending -= static_cast<unsigned>(ret);
+                        return {};
+                    }
+                    if (errno != EINTR) {
+                        return errno_to_error(errno);
+                    }
+                }
+            }
+
+            // Add a read of slot `i` at `off` to the submission queue
+            void queue(size_t i, uint64_t off)
+            {
+                auto& sl = slots[i];
+                SCN_EXPECT(!sl.in_flight);
+                sl.offset = off;
+                sl.iov.iov_base = sl.data.get();
+                sl.iov.iov_len = block_size;
+                sl.in_flight = true;
+
+                const auto tail = *sq_tail;
+                const auto idx = tail & sq_mask;
+                auto& sqe = static_cast<io_uring_sqe*>(sqes)[idx];
+                std::memset(&sqe, 0, sizeof(io_uring_sqe));
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uintptr_t>(&sl.iov);
+                sqe.len = 1;
+                sqe.off = off;
+                sqe.user_data = i;
+                sq_array[idx] = idx;
+                __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+                ++pending;
+            }
+
+            // Take the completed reads from the completion queue
+            void reap()
+            {
+                auto head = *cq_head;
+                const auto tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+                for (; head != tail; ++head) {
+                    const auto& cqe = cqes[head & cq_mask];
+                    auto& sl = slots[static_cast<size_t>(cqe.user_data)];
+                    sl.result = cqe.res;
+                    sl.in_flight = false;
+                }
+                __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+            }
+
+            error wait(size_t i)
+            {
+                reap();
+                while (slots[i].in_flight) {
+                    auto e = enter(1, IORING_ENTER_GETEVENTS);
+                    if (!e) {
+                        return e;
+                    }
+                    reap();
+                }
+                return {};
+            }
+
+            // Wait for every read in flight.
+            // On failure, the state can't be used anymore
+            error drain() noexcept
+            {
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    auto e = wait(i);
+                    if (!e) {
+                        // Can't wait for the reads in flight,
+                        // but the buffers are still being read into:
+                        // better to leak than to free them
+                        for (auto& sl : slots) {
+                            SCN_UNUSED(sl.data.release());
+                        }
+                        return e;
+                    }
+                }
+                started = false;
+                return {};
+            }
+
+            // Queue reads in every slot, starting from the file position
+            // `read_offset`, or the current position of the fd
+            error start()
+            {
+                SCN_EXPECT(!started);
+                if (!has_offset) {
+                    const auto pos = lseek(fd, 0, SEEK_CUR);
+                    if (pos == static_cast<off_t>(-1)) {
+                        return errno_to_error(errno);
+                    }
+                    read_offset = static_cast<uint64_t>(pos);
+                    has_offset = true;
+                }
+                next_slot = 0;
+                submit_offset = read_offset;
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    queue(i, submit_offset);
+                    submit_offset += block_size;
+                }
+                started = true;
+                return enter(0, 0);
+            }
+
+            std::vector<slot> slots{};
+            // Slot to be consumed next
+            size_t next_slot{0};
+            // File position of the end of the buffer of byte_uring_file,
+            // valid if has_offset
+            uint64_t read_offset{0};
+            // File position of the next read to be queued
+            uint64_t submit_offset{0};
+            size_t block_size{0};
+            bool has_offset{false};
+            bool started{false};
+
+            void* sq_ring{MAP_FAILED};
+            void* cq_ring{MAP_FAILED};
+            void* sqes{MAP_FAILED};
+            size_t sq_ring_size{0};
+            size_t cq_ring_size{0};
+            size_t sqes_size{0};
+            unsigned* sq_tail{nullptr};
+            unsigned* sq_array{nullptr};
+            unsigned* cq_head{nullptr};
+            unsigned* cq_tail{nullptr};
+            io_uring_cqe* cqes{nullptr};
+            unsigned sq_mask{0};
+            unsigned cq_mask{0};
+            // Queued, but not yet submitted
+            unsigned pending{0};
+            int ring_fd{-1};
+            int fd{-1};
+        };
+#else
+        struct byte_uring_file::uring_state {
+        };
+#endif
+
+        SCN_FUNC byte_uring_file::byte_uring_file(int fd,
+                                                  bool owning,
+                                                  size_t block_size,
+                                                  unsigned queue_depth)
+            : byte_fd_file(fd, owning, block_size)
+        {
+            SCN_EXPECT(queue_depth > 0);
+#if SCN_HAS_IO_URING
+            // Reads are queued at explicit offsets:
+            // the fd needs to be seekable
+            if (lseek(fd, 0, SEEK_CUR) != static_cast<off_t>(-1)) {
+                m_uring = uring_state::create(fd, block_size, queue_depth);
+            }
+#else
+            SCN_UNUSED(queue_depth);
+#endif
+        }
+
+        SCN_FUNC byte_uring_file::byte_uring_file(byte_uring_file&& o) noexcept
+            : byte_fd_file(SCN_MOVE(o)), m_uring(SCN_MOVE(o.m_uring))
+        {
+        }
+        SCN_FUNC byte_uring_file& byte_uring_file::operator=(
+            byte_uring_file&& o) noexcept
+        {
+            if (valid() && m_uring && !m_owning) {
+                _sync();
+            }
+            m_uring.reset();
+            byte_fd_file::operator=(SCN_MOVE(o));
+            m_uring = SCN_MOVE(o.m_uring);
+            return *this;
+        }
+
+        SCN_FUNC byte_uring_file::~byte_uring_file()
+        {
+            // If not owning, the fd is synced here, and not by
+            // byte_fd_file, which would do it by seeking backwards
+            if (valid() && m_uring && !m_owning) {
+                _sync();
+            }
+            // Waits for the reads in flight
+            m_uring.reset();
+        }
+
+        SCN_FUNC error byte_uring_file::_fill(size_t end) const
+        {
+            SCN_EXPECT(valid());
+            while (m_offset + m_size < end) {
+                auto e = _read_more();
+                if (!e) {
+                    return e;
+                }
+            }
+            return {};
+        }
+
+        SCN_FUNC void byte_uring_file::_drop_uring() const noexcept
+        {
+#if SCN_HAS_IO_URING
+            // The queued reads don't move the file position of the fd:
+            // continue reading with read() from the end of the buffer
+            if (m_uring->has_offset) {
+                lseek(m_fd, static_cast<off_t>(m_uring->read_offset),
+                      SEEK_SET);
+            }
+#endif
+            // Leaks the buffers of the reads still in flight
+            m_uring.reset();
+        }
+
+        SCN_FUNC error byte_uring_file::_read_more() const
+        {
+#if SCN_HAS_IO_URING
+            if (!m_uring) {
+                return byte_fd_file::_read_more();
+            }
+
+            auto& st = *m_uring;
+            if (!st.started) {
+                if (!st.start()) {
+                    _drop_uring();
+                    return byte_fd_file::_read_more();
+                }
+            }
+
+            while (true) {
+                auto& sl = st.slots[st.next_slot];
+                if (!st.wait(st.next_slot)) {
+                    _drop_uring();
+                    return byte_fd_file::_read_more();
+                }
+
+                if (sl.result < 0) {
+                    if (sl.result == -EINTR || sl.result == -EAGAIN) {
+                        st.queue(st.next_slot, sl.offset);
+                        if (!st.enter(0, 0)) {
+                            _drop_uring();
+                            return byte_fd_file::_read_more();
+                        }
+                        continue;
+                    }
+                    return errno_to_error(-sl.result);
+                }
+                if (sl.result == 0) {
+                    // EOF: start over from here next time,
+                    // in case the file has grown
+                    if (!st.drain()) {
+                        _drop_uring();
+                    }
+                    return {error::end_of_range, "EOF"};
+                }
+
+                const auto n = static_cast<size_t>(sl.result);
+                _prepare_append(n);
+                std::memcpy(m_data.get() + m_size, sl.data.get(), n);
+                m_size += n;
+                st.read_offset = sl.offset + n;
+
+                if (n < st.block_size) {
+                    // Short read: the reads queued after this one were
+                    // made at the wrong offsets
+                    if (!st.drain()) {
+                        _drop_uring();
+                    }
+                    return {};
+                }
+
+                st.queue(st.next_slot, st.submit_offset);
+                st.submit_offset += st.block_size;
+                st.next_slot = (st.next_slot + 1) % st.slots.size();
+                if (!st.enter(0, 0)) {
+                    // The bytes just read are still good
+                    _drop_uring();
+                }
+                return {};
+            }
+#else
+            return byte_fd_file::_read_more();
+#endif
+        }
+
+        SCN_FUNC void byte_uring_file::_sync() noexcept
+        {
+#if SCN_HAS_IO_URING
+            if (!m_uring) {
+                byte_fd_file::_sync();
+                return;
+            }
+
+            auto& st = *m_uring;
+            if (st.started && !st.drain()) {
+                _drop_uring();
+                byte_fd_file::_sync();
+                return;
+            }
+            if (st.has_offset) {
+                // The queued reads don't move the file position of the fd:
+                // set it to right after the consumed bytes
+                SCN_EXPECT(m_rollback >= m_offset);
+                const auto unconsumed = m_offset + m_size - m_rollback;
+                lseek(m_fd, static_cast<off_t>(st.read_offset - unconsumed),
+                      SEEK_SET);
+                // It may be moved by others before reading again
+                st.has_offset = false;
+            }
+            m_offset = m_rollback;
+            m_size = 0;
+#else
+            byte_fd_file::_sync();
+#endif
+        }
+
+        struct byte_prefetching_file::shared_state {
+            shared_state(FILE* f, bool w, size_t bs, size_t n)
+                : file(f), block_size(bs), max_blocks(n), wide(w)
+            {
+            }
+
+            // Read up to block_size bytes into `block`,
+            // fewer only on EOF or error, which is then returned
+            error read_block(std::string& block)
+            {
+                block.resize(block_size);
+                size_t n = 0;
+                if (!wide) {
+                    n = std::fread(&block[0], 1, block_size, file);
+                }
+                else {
+                    for (; n + sizeof(wchar_t) <= block_size;
+                         n += sizeof(wchar_t)) {
+                        wint_t ch = std::fgetwc(file);
+                        if (ch == WEOF) {
+                            break;
+                        }
+                        const auto wch = static_cast<wchar_t>(ch);
+                        std::memcpy(&block[n], &wch, sizeof(wchar_t));
+                    }
+                }
+                block.resize(n);
+                if (n == block_size) {
+                    return {};
+                }
+                if (std::feof(file) != 0) {
+                    return {error::end_of_range, "EOF"};
+                }
+                return {error::source_error, "Read error"};
+            }
+
+            void run()
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                while (true) {
+                    cv.wait(lock, [this] {
+                        return stop || ready.size() < max_blocks;
+                    });
+                    if (stop) {
+                        break;
+                    }
+
+                    std::string block{};
+                    if (!free_blocks.empty()) {
+                        block = SCN_MOVE(free_blocks.back());
+                        free_blocks.pop_back();
+                    }
+
+                    lock.unlock();
+                    auto e = read_block(block);
+                    lock.lock();
+
+                    if (!block.empty()) {
+                        ready.push_back(SCN_MOVE(block));
+                    }
+                    if (!e) {
+                        done = true;
+                        err = e;
+                    }
+                    cv.notify_all();
+                    if (done) {
+                        break;
+                    }
+                }
+            }
+
+            void start()
+            {
+                SCN_EXPECT(!thread.joinable());
+#if SCN_HAS_EXCEPTIONS
+                try {
+                    thread = std::thread{[this] { run(); }};
+                }
+                catch (const std::system_error&) {
+                    // Can't create a thread: read on the calling thread
+                    synchronous = true;
+                }
+#else
+                thread = std::thread{[this] { run(); }};
+#endif
+            }
+
+            void join() noexcept
+            {
+                if (!thread.joinable()) {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    stop = true;
+                }
+                cv.notify_all();
+                thread.join();
+                stop = false;
+            }
+
+            std::mutex mutex{};
+            std::condition_variable cv{};
+            std::thread thread{};
+            // Blocks read, not yet taken by the consumer
+            std::deque<std::string> ready{};
+            // Blocks already consumed, to be reused
+            std::vector<std::string> free_blocks{};
+            // Why reading stopped, if done
+            error err{};
+            FILE* file;
+            size_t block_size;
+            size_t max_blocks;
+            bool wide;
+            bool stop{false};
+            bool done{false};
+            bool synchronous{false};
+        };
+
+        SCN_FUNC byte_prefetching_file::byte_prefetching_file(
+            FILE* f,
+            bool wide,
+            size_t block_size,
+            size_t blocks)
+            : m_state(new shared_state{f, wide, block_size, blocks}),
+              m_file(f)
+        {
+            SCN_EXPECT(block_size > 0);
+            SCN_EXPECT(blocks > 0);
+        }
+
+        SCN_FUNC byte_prefetching_file::byte_prefetching_file(
+            byte_prefetching_file&& o) noexcept
+            : m_buffer(SCN_MOVE(o.m_buffer)),
+              m_offset(exchange(o.m_offset, size_t{0})),
+              m_rollback(exchange(o.m_rollback, size_t{0})),
+              m_state(SCN_MOVE(o.m_state)),
+              m_file(exchange(o.m_file, nullptr))
+        {
+        }
+        SCN_FUNC byte_prefetching_file& byte_prefetching_file::operator=(
+            byte_prefetching_file&& o) noexcept
+        {
+            if (valid()) {
+                _destruct();
+            }
+
+            // The reader thread only refers to the shared state,
+            // so it doesn't need to be stopped
+            m_buffer = SCN_MOVE(o.m_buffer);
+            m_offset = exchange(o.m_offset, size_t{0});
+            m_rollback = exchange(o.m_rollback, size_t{0});
+            m_state = SCN_MOVE(o.m_state);
+            m_file = exchange(o.m_file, nullptr);
+            return *this;
+        }
+
+        SCN_FUNC byte_prefetching_file::~byte_prefetching_file()
+        {
+            if (valid()) {
+                _destruct();
+            }
+        }
+
+        SCN_FUNC error byte_prefetching_file::_fill(size_t end) const
+        {
+            SCN_EXPECT(valid());
+            while (m_offset + m_buffer.size() < end) {
+                auto e = _read_more();
+                if (!e) {
+                    return e;
+                }
+            }
+            return {};
+        }
+
+        SCN_FUNC error byte_prefetching_file::_read_more() const
+        {
+            auto& st = *m_state;
+
+            std::string block{};
+            if (st.synchronous) {
+                if (st.done) {
+                    return st.err;
+                }
+                auto e = st.read_block(block);
+                if (!e) {
+                    st.done = true;
+                    st.err = e;
+                }
+                if (block.empty()) {
+                    return st.err;
+                }
+            }
+            else {
+                if (!st.thread.joinable() && !st.done) {
+                    st.start();
+                    if (st.synchronous) {
+                        return _read_more();
+                    }
+                }
+
+                std::unique_lock<std::mutex> lock{st.mutex};
+                st.cv.wait(lock,
+                           [&st] { return !st.ready.empty() || st.done; });
+                if (st.ready.empty()) {
+                    return st.err;
+                }
+                block = SCN_MOVE(st.ready.front());
+                st.ready.pop_front();
+                st.cv.notify_all();
+            }
+
+            // Discard everything before the rollback point
+            SCN_EXPECT(m_rollback >= m_offset);
+            if (m_rollback != m_offset) {
+                m_buffer.erase(0, m_rollback - m_offset);
+                m_offset = m_rollback;
+            }
+            m_buffer.append(block);
+
+            if (!st.synchronous) {
+                std::lock_guard<std::mutex> lock{st.mutex};
+                st.free_blocks.push_back(SCN_MOVE(block));
+            }
+            return {};
+        }
+
+        SCN_FUNC void byte_prefetching_file::_sync() noexcept
+        {
+            SCN_EXPECT(valid());
+            auto& st = *m_state;
+            st.join();
+
+            SCN_EXPECT(m_rollback >= m_offset);
+            SCN_TRY
+            {
+                // Everything read, but not consumed, in the order it was read
+                std::string unread = m_buffer.substr(m_rollback - m_offset);
+                for (auto& block : st.ready) {
+                    unread.append(block);
+                }
+
+                size_t left{};
+                if (!st.wide) {
+                    left = put_back_to_file(m_file, unread.data(),
+                                            unread.size());
+                }
+                else {
+                    std::wstring wunread(unread.size() / sizeof(wchar_t),
+                                         L'\0');
+                    std::memcpy(&wunread[0], unread.data(),
+                                wunread.size() * sizeof(wchar_t));
+                    left = put_back_to_file(m_file, wunread.data(),
+                                            wunread.size()) *
+                           sizeof(wchar_t);
+                }
+
+                // The characters that couldn't be put back are read first
+                unread.resize(left);
+                m_buffer.swap(unread);
+            }
+            SCN_CATCH(const std::bad_alloc&)
+            {
+                // Nowhere to put the characters: they're lost
+                m_buffer.clear();
+            }
+            st.ready.clear();
+
+            m_offset = m_rollback;
+            // Reading can be continued: the FILE* may have more to read,
+            // or the error may have been cleared
+            st.done = false;
+            st.err = error{};
+        }
+
+        SCN_FUNC void byte_prefetching_file::_destruct() noexcept
+        {
+            _sync();
+            if (!m_buffer.empty()) {
+                // Leave what couldn't be put back to the next file range
+                // reading from m_file
+                SCN_TRY
+                {
+                    if (!m_state->wide) {
+                        put_file_handoff(m_file, SCN_MOVE(m_buffer));
+                    }
+                    else {
+                        std::wstring left(m_buffer.size() / sizeof(wchar_t),
+                                          L'\0');
+                        std::memcpy(&left[0], m_buffer.data(),
+                                    left.size() * sizeof(wchar_t));
+                        put_file_handoff(m_file, SCN_MOVE(left));
+                    }
+                }
+                SCN_CATCH(const std::bad_alloc&)
+                {
+                    // Nowhere to put the characters: they're lost
+                }
+            }
+            m_state.reset();
+            m_file = nullptr;
+            m_buffer.clear();
+            m_offset = m_rollback = 0;
 
             SCN_ENSURE(!valid());
         }
@@ -163,6 +1446,147 @@ namespace scn {
     }  // namespace detail
 
     namespace detail {
+        template <typename CharT>
+        struct file_handoff_registry {
+            std::atomic_flag lock = ATOMIC_FLAG_INIT;
+            std::vector<std::pair<FILE*, std::basic_string<CharT>>> entries{};
+        };
+
+        SCN_CLANG_PUSH
+        SCN_CLANG_IGNORE("-Wexit-time-destructors")
+
+        template <typename CharT>
+        file_handoff_registry<CharT>& get_file_handoff_registry()
+        {
+            static file_handoff_registry<CharT> r;
+            return r;
+        }
+
+        SCN_CLANG_POP
+
+        // Only ever held for a short while (no I/O is done while locked),
+        // so a spinlock is enough
+        class file_handoff_lock {
+        public:
+            file_handoff_lock(std::atomic_flag& f) : m_flag(f)
+            {
+                while (m_flag.test_and_set(std::memory_order_acquire)) {
+                }
+            }
+            ~file_handoff_lock()
+            {
+                m_flag.clear(std::memory_order_release);
+            }
+
+            file_handoff_lock(const file_handoff_lock&) = delete;
+            file_handoff_lock& operator=(const file_handoff_lock&) = delete;
+
+        private:
+            std::atomic_flag& m_flag;
+        };
+
+        template <typename CharT>
+        void put_file_handoff_impl(FILE* f, std::basic_string<CharT> s)
+        {
+            auto& r = get_file_handoff_registry<CharT>();
+            file_handoff_lock lock{r.lock};
+            for (auto& e : r.entries) {
+                if (e.first == f) {
+                    // The characters already here were read from f before s
+                    e.second.append(s);
+                    return;
+                }
+            }
+            r.entries.emplace_back(f, SCN_MOVE(s));
+        }
+        template <typename CharT>
+        void take_file_handoff_impl(FILE* f, std::basic_string<CharT>& s)
+        {
+            auto& r = get_file_handoff_registry<CharT>();
+            file_handoff_lock lock{r.lock};
+            for (auto it = r.entries.begin(); it != r.entries.end(); ++it) {
+                if (it->first == f) {
+                    if (s.empty()) {
+                        s.swap(it->second);
+                    }
+                    else {
+                        s.append(it->second);
+                    }
+                    r.entries.erase(it);
+                    return;
+                }
+            }
+        }
+        template <typename CharT>
+        void discard_file_handoff_impl(FILE* f) noexcept
+        {
+            auto& r = get_file_handoff_registry<CharT>();
+            file_handoff_lock lock{r.lock};
+            for (auto it = r.entries.begin(); it != r.entries.end(); ++it) {
+                if (it->first == f) {
+                    r.entries.erase(it);
+                    return;
+                }
+            }
+        }
+
+        SCN_FUNC void put_file_handoff(FILE* f, std::string s)
+        {
+            put_file_handoff_impl(f, SCN_MOVE(s));
+        }
+        SCN_FUNC void put_file_handoff(FILE* f, std::wstring s)
+        {
+            put_file_handoff_impl(f, SCN_MOVE(s));
+        }
+        SCN_FUNC void take_file_handoff(FILE* f, std::string& s)
+        {
+            take_file_handoff_impl(f, s);
+        }
+        SCN_FUNC void take_file_handoff(FILE* f, std::wstring& s)
+        {
+            take_file_handoff_impl(f, s);
+        }
+
+        SCN_FUNC size_t put_back_to_file(FILE* f,
+                                         const char* s,
+                                         size_t n) noexcept
+        {
+            if (n == 0) {
+                return 0;
+            }
+#if SCN_POSIX
+            // On POSIX, there's no distinction between text and binary
+            // streams, so we can seek back by the number of characters.
+            // Check that the stream is seekable first: for pipes, fseek
+            // may seek within the stdio buffer only, and report success.
+            if (std::ftell(f) != -1 &&
+                std::fseek(f, -static_cast<long>(n), SEEK_CUR) == 0) {
+                return 0;
+            }
+#endif
+            // Only a single character is guaranteed to be accepted,
+            // but some implementations (glibc) take any number
+            for (; n != 0; --n) {
+                if (std::ungetc(static_cast<unsigned char>(s[n - 1]), f) ==
+                    EOF) {
+                    break;
+                }
+            }
+            return n;
+        }
+        SCN_FUNC size_t put_back_to_file(FILE* f,
+                                         const wchar_t* s,
+                                         size_t n) noexcept
+        {
+            // Wide streams can't be seeked by a number of characters
+            for (; n != 0; --n) {
+                if (std::ungetwc(static_cast<wint_t>(s[n - 1]), f) == WEOF) {
+                    break;
+                }
+            }
+            return n;
+        }
+
         template <typename CharT>
         struct basic_file_iterator_access {
             using iterator = typename basic_file<CharT>::iterator;
@@ -175,7 +1599,7 @@ namespace scn {
 
                 if (self.m_file->m_buffer.empty()) {
                     // no chars have been read
-                    return self.m_file->_read_single();
+                    return self.m_file->_read_some();
                 }
                 if (!self.m_last_error) {
                     // last read failed
@@ -191,7 +1615,7 @@ namespace scn {
                         self.m_last_error.code() != error::end_of_range &&
                         !o.m_file) {
                         self.m_last_error = error{};
-                        auto r = self.m_file->_read_single();
+                        auto r = self.m_file->_read_some();
                         if (!r) {
                             self.m_last_error = r.error();
                             return !o.m_file || self.m_current == o.m_current ||
@@ -227,6 +1651,12 @@ namespace scn {
         };
     }  // namespace detail
 
+    SCN_FUNC void discard_file_handoff(FILE* f) noexcept
+    {
+        detail::discard_file_handoff_impl<char>(f);
+        detail::discard_file_handoff_impl<wchar_t>(f);
+    }
+
     template <>
     SCN_FUNC expected<char> basic_file<char>::iterator::operator*() const
     {
@@ -252,59 +1682,82 @@ namespace scn {
     }
 
     template <>
-    SCN_FUNC expected<char> file::_read_single() const
+    SCN_FUNC expected<char> file::_read_some() const
     {
         SCN_EXPECT(valid());
-        int tmp = std::fgetc(m_file);
-        if (tmp == EOF) {
+        _shrink_to_window(m_block_size);
+        const auto prev_size = m_buffer.size();
+        m_buffer.resize(prev_size + m_block_size);
+        const auto n =
+            std::fread(&m_buffer[prev_size], 1, m_block_size, m_file);
+        m_buffer.resize(prev_size + n);
+        if (n == 0) {
             if (std::feof(m_file) != 0) {
                 return error(error::end_of_range, "EOF");
             }
             if (std::ferror(m_file) != 0) {
-                return error(error::source_error, "fgetc error");
+                return error(error::source_error, "fread error");
             }
             return error(error::unrecoverable_source_error,
-                         "Unknown fgetc error");
+                         "Unknown fread error");
         }
-        auto ch = static_cast<char>(tmp);
-        m_buffer.push_back(ch);
-        return ch;
+        return m_buffer[prev_size];
     }
     template <>
-    SCN_FUNC expected<wchar_t> wfile::_read_single() const
+    SCN_FUNC expected<wchar_t> wfile::_read_some() const
     {
         SCN_EXPECT(valid());
-        wint_t tmp = std::fgetwc(m_file);
-        if (tmp == WEOF) {
+        _shrink_to_window(m_block_size);
+        const auto prev_size = m_buffer.size();
+        for (size_t i = 0; i < m_block_size; ++i) {
+            wint_t tmp = std::fgetwc(m_file);
+            if (tmp == WEOF) {
+                break;
+            }
+            m_buffer.push_back(static_cast<wchar_t>(tmp));
+        }
+        if (m_buffer.size() == prev_size) {
             if (std::feof(m_file) != 0) {
                 return error(error::end_of_range, "EOF");
             }
             if (std::ferror(m_file) != 0) {
-                return error(error::source_error, "fgetc error");
+                return error(error::source_error, "fgetwc error");
             }
             return error(error::unrecoverable_source_error,
-                         "Unknown fgetc error");
+                         "Unknown fgetwc error");
         }
-        auto ch = static_cast<wchar_t>(tmp);
-        m_buffer.push_back(ch);
-        return ch;
+        return m_buffer[prev_size];
     }
 
+    namespace detail {
+        template <typename CharT>
+        void sync_file_buffer(FILE* f,
+                              std::basic_string<CharT>& buf,
+                              size_t pos) noexcept
+        {
+            SCN_EXPECT(pos <= buf.size());
+            const auto left =
+                put_back_to_file(f, buf.data() + pos, buf.size() - pos);
+            // Keep the characters that couldn't be put back,
+            // to be read first
+            buf.erase(pos + left);
+            buf.erase(0, pos);
+        }
+    }  // namespace detail
+
     template <>
     SCN_FUNC void file::_sync_until(std::size_t pos) noexcept
     {
-        for (auto it = m_buffer.rbegin();
-             it != m_buffer.rend() - static_cast<std::ptrdiff_t>(pos); ++it) {
-            std::ungetc(static_cast<unsigned char>(*it), m_file);
-        }
+        detail::sync_file_buffer(m_file, m_buffer, pos);
+        m_offset = 0;
+        m_rollback = 0;
     }
     template <>
     SCN_FUNC void wfile::_sync_until(std::size_t pos) noexcept
     {
-        for (auto it = m_buffer.rbegin();
-             it != m_buffer.rend() - static_cast<std::ptrdiff_t>(pos); ++it) {
-            std::ungetwc(static_cast<wint_t>(*it), m_file);
-        }
+        detail::sync_file_buffer(m_file, m_buffer, pos);
+        m_offset = 0;
+        m_rollback = 0;
     }
 
     SCN_END_NAMESPACE
@@ -43,6 +43,7 @@ namespace scn {
 
             string_type truename{};
             string_type falsename{};
+            std::string grouping{};
             char_type decimal_point{};
             char_type thousands_separator{};
         };
@@ -92,6 +93,7 @@ namespace scn {
             data.falsename = facet.falsename();
             data.decimal_point = facet.decimal_point();
             data.thousands_separator = facet.thousands_sep();
+            data.grouping = facet.grouping();
         }
 
         template <typename CharT>
@@ -143,12 +145,14 @@ namespace scn {
         {
             m_locale =
                 &static_cast<locale_data<CharT>*>(m_data)->classic_locale;
+            _initialize();
         }
         template <typename CharT>
         void basic_custom_locale_ref<CharT>::convert_to_global()
         {
             SCN_EXPECT(m_data);
             m_locale = &static_cast<locale_data<CharT>*>(m_data)->global_locale;
+            _initialize();
         }
 
         template <typename CharT>
@@ -176,6 +180,13 @@ namespace scn {
                 ->thousands_separator;
         }
         template <typename CharT>
+        string_view basic_custom_locale_ref<CharT>::grouping() const
+        {
+            const auto& str =
+                static_cast<locale_data<CharT>*>(m_data)->grouping;
+            return {str.data(), str.size()};
+        }
+        template <typename CharT>
         auto basic_custom_locale_ref<CharT>::do_truename() const
             -> string_view_type
         {
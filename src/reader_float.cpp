@@ -23,7 +23,17 @@
 #include <scn/reader/float.h>
 
 #include <cerrno>
+#include <climits>
 #include <clocale>
+#include <cmath>
+#include <limits>
+
+#if SCN_POSIX
+#include <locale.h>
+#if SCN_APPLE
+#include <xlocale.h>
+#endif
+#endif
 
 #if SCN_HAS_FLOAT_CHARCONV
 #include <charconv>
@@ -57,6 +67,10 @@ namespace scn {
     namespace read_float {
         static bool is_hexfloat(const char* str, std::size_t len) noexcept
         {
+            if (len != 0 && (str[0] == '-' || str[0] == '+')) {
+                ++str;
+                --len;
+            }
             if (len < 3) {
                 return false;
             }
@@ -64,6 +78,10 @@ namespace scn {
         }
         static bool is_hexfloat(const wchar_t* str, std::size_t len) noexcept
         {
+            if (len != 0 && (str[0] == L'-' || str[0] == L'+')) {
+                ++str;
+                --len;
+            }
             if (len < 3) {
                 return false;
             }
@@ -71,6 +89,85 @@ namespace scn {
         }
 
         namespace cstd {
+            // strtod and friends respect LC_NUMERIC, but we always want to
+            // parse in the "C" locale. Switching the global locale with
+            // setlocale races with other threads, so where possible, a
+            // locale object is created once and used per call instead.
+#if SCN_POSIX
+            static locale_t c_locale()
+            {
+                static const locale_t loc =
+                    ::newlocale(LC_ALL_MASK, "C", locale_t{});
+                return loc;
+            }
+
+            // uselocale only affects the calling thread
+            class c_locale_scope {
+            public:
+                c_locale_scope()
+                    : m_prev(c_locale() ? ::uselocale(c_locale()) : locale_t{})
+                {
+                }
+                c_locale_scope(const c_locale_scope&) = delete;
+                c_locale_scope& operator=(const c_locale_scope&) = delete;
+                ~c_locale_scope()
+                {
+                    if (m_prev) {
+                        ::uselocale(m_prev);
+                    }
+                }
+
+            private:
+                locale_t m_prev;
+            };
+
+#define SCN_CSTD_STRTOD(f, str, end) ::f(str, end)
+#elif SCN_WINDOWS && SCN_MSVC
+            static _locale_t c_locale()
+            {
+                static const _locale_t loc = ::_create_locale(LC_ALL, "C");
+                return loc;
+            }
+
+            // The _l functions take the locale as an argument
+            class c_locale_scope {
+            public:
+                c_locale_scope() {}
+            };
+
+#define SCN_CSTD_STRTOD(f, str, end) ::_##f##_l(str, end, c_locale())
+#else
+            // No per-thread locales: fall back to setlocale,
+            // which isn't thread-safe
+            class c_locale_scope {
+            public:
+                c_locale_scope()
+                {
+                    // Get current C locale
+                    const auto loc = std::setlocale(LC_NUMERIC, nullptr);
+                    // For whatever reason, this cannot be stored in the heap
+                    // if setlocale hasn't been called before, or msan errors
+                    // with 'use-of-unitialized-value' when resetting the
+                    // locale back. POSIX specifies that the content of loc
+                    // may not be static, so we need to save it ourselves
+                    std::strcpy(m_prev, loc);
+
+                    std::setlocale(LC_NUMERIC, "C");
+                }
+                c_locale_scope(const c_locale_scope&) = delete;
+                c_locale_scope& operator=(const c_locale_scope&) = delete;
+                ~c_locale_scope()
+                {
+                    std::setlocale(LC_NUMERIC, m_prev);
+                }
+
+            private:
+                char m_prev[64] = {0};
+            };
+
+#define SCN_CSTD_STRTOD(f, str, end) ::f(str, end)
+#endif
+
 #if SCN_GCC >= SCN_COMPILER(7, 0, 0)
             SCN_GCC_PUSH
             SCN_GCC_IGNORE("-Wnoexcept-type")
@@ -79,28 +176,38 @@ namespace scn {
             expected<T> impl(F&& f_strtod,
                              T huge_value,
                              const CharT* str,
+                             std::size_t len,
                              size_t& chars,
-                             uint8_t options)
+                             uint8_t options,
+                             CharT decimal_point)
             {
-                // Get current C locale
-                const auto loc = std::setlocale(LC_NUMERIC, nullptr);
-                // For whatever reason, this cannot be stored in the heap if
-                // setlocale hasn't been called before, or msan errors with
-                // 'use-of-unitialized-value' when resetting the locale back.
-                // POSIX specifies that the content of loc may not be static, so
-                // we need to save it ourselves
-                char locbuf[64] = {0};
-                std::strcpy(locbuf, loc);
-
-                std::setlocale(LC_NUMERIC, "C");
+                // strtod needs a NUL-terminated string:
+                // copy the input, usually onto the stack
+                detail::small_vector<CharT, 64> buf(len + 1, CharT{0});
+                std::char_traits<CharT>::copy(buf.data(), str, len);
+                if (decimal_point != detail::ascii_widen<CharT>('.')) {
+                    // In the "C" locale, the decimal point is '.'
+                    for (std::size_t i = 0; i != len; ++i) {
+                        if (buf[i] == detail::ascii_widen<CharT>('.')) {
+                            buf[i] = CharT{0};
+                            break;
+                        }
+                        if (buf[i] == decimal_point) {
+                            buf[i] = detail::ascii_widen<CharT>('.');
+                        }
+                    }
+                }
 
                 CharT* end{};
-                errno = 0;
-                T f = f_strtod(str, &end);
-                chars = static_cast<size_t>(end - str);
-                auto err = errno;
-                // Reset locale
-                std::setlocale(LC_NUMERIC, locbuf);
+                T f{};
+                int err{};
+                {
+                    c_locale_scope scope{};
+                    errno = 0;
+                    f = f_strtod(buf.data(), &end);
+                    err = errno;
+                }
+                chars = static_cast<size_t>(end - buf.data());
                 errno = 0;
 
                 SCN_GCC_COMPAT_PUSH
@@ -126,7 +233,7 @@ namespace scn {
                     // Subnormals cause ERANGE but a value is still returned
                 }
 
-                if (is_hexfloat(str, detail::strlen(str)) &&
+                if (is_hexfloat(str, len) &&
                     (options & detail::float_scanner<T>::allow_hex) == 0) {
                     return error(error::invalid_scanned_value,
                                  "Hexfloats not allowed by the format string");
@@ -145,62 +252,103 @@ namespace scn {
             template <>
             struct read<char, float> {
                 static expected<float> get(const char* str,
+                                           std::size_t len,
                                            size_t& chars,
-                                           uint8_t options)
+                                           uint8_t options,
+                                           char decimal_point)
                 {
-                    return impl<float>(strtof, HUGE_VALF, str, chars, options);
+                    return impl<float>(
+                        [](const char* s, char** end) {
+                            return SCN_CSTD_STRTOD(strtof, s, end);
+                        },
+                        HUGE_VALF, str, len, chars, options,
+                        decimal_point);
                 }
             };
 
             template <>
             struct read<char, double> {
                 static expected<double> get(const char* str,
+                                            std::size_t len,
                                             size_t& chars,
-                                            uint8_t options)
+                                            uint8_t options,
+                                            char decimal_point)
                 {
-                    return impl<double>(strtod, HUGE_VAL, str, chars, options);
+                    return impl<double>(
+                        [](const char* s, char** end) {
+                            return SCN_CSTD_STRTOD(strtod, s, end);
+                        },
+                        HUGE_VAL, str, len, chars, options,
+                        decimal_point);
                 }
             };
 
             template <>
             struct read<char, long double> {
                 static expected<long double> get(const char* str,
+                                                 std::size_t len,
                                                  size_t& chars,
-                                                 uint8_t options)
+                                                 uint8_t options,
+                                                 char decimal_point)
                 {
-                    return impl<long double>(strtold, HUGE_VALL, str, chars,
-                                             options);
+                    return impl<long double>(
+                        [](const char* s, char** end) {
+                            return SCN_CSTD_STRTOD(strtold, s, end);
+                        },
+                        HUGE_VALL, str, len, chars, options,
+                        decimal_point);
                 }
             };
 
             template <>
             struct read<wchar_t, float> {
                 static expected<float> get(const wchar_t* str,
+                                           std::size_t len,
                                            size_t& chars,
-                                           uint8_t options)
+                                           uint8_t options,
+                                           wchar_t decimal_point)
                 {
-                    return impl<float>(wcstof, HUGE_VALF, str, chars, options);
+                    return impl<float>(
+                        [](const wchar_t* s, wchar_t** end) {
+                            return SCN_CSTD_STRTOD(wcstof, s, end);
+                        },
+                        HUGE_VALF, str, len, chars, options,
+                        decimal_point);
                 }
             };
             template <>
             struct read<wchar_t, double> {
                 static expected<double> get(const wchar_t* str,
+                                            std::size_t len,
                                             size_t& chars,
-                                            uint8_t options)
+                                            uint8_t options,
+                                            wchar_t decimal_point)
                 {
-                    return impl<double>(wcstod, HUGE_VAL, str, chars, options);
+                    return impl<double>(
+                        [](const wchar_t* s, wchar_t** end) {
+                            return SCN_CSTD_STRTOD(wcstod, s, end);
+                        },
+                        HUGE_VAL, str, len, chars, options,
+                        decimal_point);
                 }
             };
             template <>
             struct read<wchar_t, long double> {
                 static expected<long double> get(const wchar_t* str,
+                                                 std::size_t len,
                                                  size_t& chars,
-                                                 uint8_t options)
+                                                 uint8_t options,
+                                                 wchar_t decimal_point)
                 {
-                    return impl<long double>(wcstold, HUGE_VALL, str, chars,
-                                             options);
+                    return impl<long double>(
+                        [](const wchar_t* s, wchar_t** end) {
+                            return SCN_CSTD_STRTOD(wcstold, s, end);
+                        },
+                        HUGE_VALL, str, len, chars, options,
+                        decimal_point);
                 }
             };
+#undef SCN_CSTD_STRTOD
         }  // namespace cstd
 
         namespace from_chars {
@@ -208,26 +356,26 @@ namespace scn {
             template <typename T>
             struct read {
                 static expected<T> get(const char* str,
+                                       std::size_t len,
                                        size_t& chars,
-                                       uint8_t options)
+                                       uint8_t options,
+                                       char decimal_point)
                 {
-                    const auto len = std::strlen(str);
+                    if (decimal_point != '.') {
+                        // from_chars only knows '.'
+                        return cstd::read<char, T>::get(str, len, chars,
+                                                        options, decimal_point);
+                    }
+
+                    // Hexfloats are handled by hexfloat::read
                     std::chars_format flags{};
-                    if (((options & detail::float_scanner<T>::allow_hex) !=
-                         0) &&
-                        is_hexfloat(str, len)) {
-                        str += 2;
-                        flags = std::chars_format::hex;
+                    if ((options & detail::float_scanner<T>::allow_fixed) !=
+                        0) {
+                        flags |= std::chars_format::fixed;
                     }
-                    else {
-                        if ((options & detail::float_scanner<T>::allow_fixed) !=
-                            0) {
-                            flags |= std::chars_format::fixed;
-                        }
-                        if ((options &
-                             detail::float_scanner<T>::allow_scientific) != 0) {
-                            flags |= std::chars_format::scientific;
-                        }
+                    if ((options &
+                         detail::float_scanner<T>::allow_scientific) != 0) {
+                        flags |= std::chars_format::scientific;
                     }
                     if (flags == static_cast<std::chars_format>(0)) {
                         return error{error::invalid_scanned_value,
@@ -244,7 +392,8 @@ namespace scn {
                     if (result.ec == std::errc::result_out_of_range) {
                         // Out of range, may be subnormal -> fall back to strtod
                         // On gcc std::from_chars doesn't parse subnormals
-                        return cstd::read<char, T>::get(str, chars, options);
+                        return cstd::read<char, T>::get(str, len, chars,
+                                                        options, decimal_point);
                     }
                     chars = static_cast<size_t>(result.ptr - str);
                     return value;
@@ -254,32 +403,372 @@ namespace scn {
             template <typename T>
             struct read {
                 static expected<T> get(const char* str,
+                                       std::size_t len,
                                        size_t& chars,
-                                       uint8_t options)
+                                       uint8_t options,
+                                       char decimal_point)
                 {
                     // Fall straight back to strtod
-                    return cstd::read<char, T>::get(str, chars, options);
+                    return cstd::read<char, T>::get(str, len, chars, options,
+                                                    decimal_point);
                 }
             };
 #endif
         }  // namespace from_chars
 
+        namespace hexfloat {
+            // Holds the significant bits of the input:
+            // needs room for digits + 1 (rounding bit) bits,
+            // and the leading hex digit can have up to 3 leading zero bits
+#if SCN_HAS_INT128
+            using wide_mantissa = detail::uint128;
+#else
+            using wide_mantissa = std::uint64_t;
+#endif
+            template <typename T>
+            using mantissa_type = typename std::conditional<
+                std::numeric_limits<T>::digits + 4 <= 64,
+                std::uint64_t,
+                wide_mantissa>::type;
+
+            template <typename T>
+            struct is_supported
+                : std::integral_constant<
+                      bool,
+                      std::numeric_limits<T>::radix == 2 &&
+                          std::numeric_limits<T>::digits + 4 <=
+                              static_cast<int>(sizeof(mantissa_type<T>) *
+                                               CHAR_BIT)> {
+            };
+
+            static int hex_digit_value(char ch) noexcept
+            {
+                if (ch >= '0' && ch <= '9') {
+                    return ch - '0';
+                }
+                if (ch >= 'a' && ch <= 'f') {
+                    return ch - 'a' + 10;
+                }
+                if (ch >= 'A' && ch <= 'F') {
+                    return ch - 'A' + 10;
+                }
+                return -1;
+            }
+
+            template <typename U>
+            int bit_length(U val) noexcept
+            {
+                int n = 0;
+                for (; val != 0; val >>= 1) {
+                    ++n;
+                }
+                return n;
+            }
+
+            /**
+             * Parse a hexfloat ([+-]0x<hex>[.<hex>][p[+-]<dec>]) from the
+             * beginning of [str, str + len), which is_hexfloat has checked.
+             * The result is rounded to nearest, ties to even.
+             */
+            template <typename T>
+            expected<T> read(const char* str,
+                             std::size_t len,
+                             size_t& chars,
+                             uint8_t options,
+                             char decimal_point)
+            {
+                using mant_type = mantissa_type<T>;
+                if (!is_supported<T>::value) {
+                    return cstd::read<char, T>::get(str, len, chars, options,
+                                                    decimal_point);
+                }
+
+                const char* it = str;
+                const char* const end = str + len;
+
+                bool negative = false;
+                if (*it == '-' || *it == '+') {
+                    negative = *it == '-';
+                    ++it;
+                }
+                // "0x"
+                const char* const zero = it;
+                it += 2;
+
+                // The value is mant * 2^exp2, plus a nonzero remainder
+                // smaller than that if sticky is set
+                constexpr int max_hex_digits =
+                    static_cast<int>(sizeof(mant_type)) * 2;
+                mant_type mant = 0;
+                int mant_hex_digits = 0;
+                bool sticky = false;
+                long exp2 = 0;
+                bool has_digits = false;
+
+                for (; it != end; ++it) {
+                    const auto d = hex_digit_value(*it);
+                    if (d < 0) {
+                        break;
+                    }
+                    has_digits = true;
+                    if (mant_hex_digits == max_hex_digits) {
+                        sticky = sticky || d != 0;
+                        exp2 += 4;
+                    }
+                    else if (mant != 0 || d != 0) {
+                        mant = static_cast<mant_type>(
+                            (mant << 4) | static_cast<mant_type>(d));
+                        ++mant_hex_digits;
+                    }
+                }
+                if (it != end && *it == decimal_point) {
+                    auto frac = it + 1;
+                    for (; frac != end; ++frac) {
+                        const auto d = hex_digit_value(*frac);
+                        if (d < 0) {
+                            break;
+                        }
+                        has_digits = true;
+                        if (mant_hex_digits == max_hex_digits) {
+                            sticky = sticky || d != 0;
+                            continue;
+                        }
+                        if (mant != 0 || d != 0) {
+                            mant = static_cast<mant_type>(
+                                (mant << 4) | static_cast<mant_type>(d));
+                            ++mant_hex_digits;
+                        }
+                        exp2 -= 4;
+                    }
+                    if (has_digits) {
+                        it = frac;
+                    }
+                }
+                if (!has_digits) {
+                    // Just the "0", like strtod
+                    chars = static_cast<size_t>(zero + 1 - str);
+                    return negative ? -detail::zero_value<T>::value
+                                    : detail::zero_value<T>::value;
+                }
+
+                if (it != end && (*it == 'p' || *it == 'P')) {
+                    auto e = it + 1;
+                    bool exp_negative = false;
+                    if (e != end && (*e == '-' || *e == '+')) {
+                        exp_negative = *e == '-';
+                        ++e;
+                    }
+                    if (e != end && *e >= '0' && *e <= '9') {
+                        // Saturates far outside of the range of any T
+                        long exp = 0;
+                        for (; e != end && *e >= '0' && *e <= '9'; ++e) {
+                            if (exp < 100000) {
+                                exp = exp * 10 + (*e - '0');
+                            }
+                        }
+                        exp2 += exp_negative ? -exp : exp;
+                        it = e;
+                    }
+                }
+                chars = static_cast<size_t>(it - str);
+
+                if (mant == 0) {
+                    return negative ? -detail::zero_value<T>::value
+                                    : detail::zero_value<T>::value;
+                }
+
+                // Round to the precision available at this exponent:
+                // less than digits for subnormals
+                const int nbits = bit_length(mant);
+                const long lead = exp2 + nbits - 1;
+                const long min_lead = std::numeric_limits<T>::min_exponent - 1;
+                long precision = std::numeric_limits<T>::digits;
+                if (lead < min_lead) {
+                    precision -= min_lead - lead;
+                }
+                if (nbits > precision) {
+                    const long shift = nbits - precision;
+                    if (shift > nbits) {
+                        // Less than half of the smallest subnormal
+                        mant = 0;
+                    }
+                    else {
+                        const auto s = static_cast<int>(shift);
+                        const auto half = static_cast<mant_type>(
+                            mant_type{1} << (s - 1));
+                        const bool round_bit = (mant & half) != 0;
+                        const bool below_half =
+                            sticky || (mant & (half - 1)) != 0;
+                        mant = static_cast<mant_type>((mant >> (s - 1)) >> 1);
+                        exp2 += shift;
+                        if (round_bit && (below_half || (mant & 1) != 0)) {
+                            ++mant;
+                        }
+                    }
+                }
+
+                if (mant == 0) {
+                    return error(error::value_out_of_range,
+                                 "Floating-point value out of range: "
+                                 "underflow");
+                }
+                if (exp2 + bit_length(mant) - 1 >=
+                    std::numeric_limits<T>::max_exponent) {
+                    return error(error::value_out_of_range,
+                                 "Floating-point value out of range: "
+                                 "overflow");
+                }
+
+                // Exact: mant fits into the significand
+                const T value =
+                    std::ldexp(static_cast<T>(mant), static_cast<int>(exp2));
+                return negative ? -value : value;
+            }
+        }  // namespace hexfloat
+
+        namespace fast_path {
+            // Largest n for which 10^n is exact in T
+            template <typename T>
+            int max_exact_pow10() noexcept
+            {
+                int n = 0;
+                const T limit = std::ldexp(static_cast<T>(1),
+                                           std::numeric_limits<T>::digits);
+                for (T p5 = 5; p5 < limit; p5 *= 5) {
+                    ++n;
+                }
+                return n;
+            }
+
+            /**
+             * Clinger's fast path for types fast_float doesn't support:
+             * if the decimal significand and the power of ten are both
+             * exact in T, a single multiplication or division rounds
+             * correctly. Only plain [+-]digits[.digits][e[+-]digits] is
+             * accepted; returns false if the input is something else, or
+             * out of reach of the fast path.
+             */
+            template <typename T>
+            bool read(const char* str,
+                      std::size_t len,
+                      size_t& chars,
+                      char decimal_point,
+                      T& val)
+            {
+                const char* it = str;
+                const char* const end = str + len;
+
+                bool negative = false;
+                if (it != end && (*it == '-' || *it == '+')) {
+                    negative = *it == '-';
+                    ++it;
+                }
+
+                std::uint64_t mant = 0;
+                int mant_digits = 0;
+                long exp10 = 0;
+                bool has_digits = false;
+                const auto accumulate = [&](char ch) {
+                    has_digits = true;
+                    if (mant == 0 && ch == '0') {
+                        return true;
+                    }
+                    if (mant_digits == 19) {
+                        return false;
+                    }
+                    mant = mant * 10 + static_cast<std::uint64_t>(ch - '0');
+                    ++mant_digits;
+                    return true;
+                };
+
+                for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+                    if (!accumulate(*it)) {
+                        return false;
+                    }
+                }
+                if (it != end && *it == decimal_point) {
+                    auto frac = it + 1;
+                    for (; frac != end && *frac >= '0' && *frac <= '9';
+                         ++frac) {
+                        if (!accumulate(*frac)) {
+                            return false;
+                        }
+                        --exp10;
+                    }
+                    if (has_digits) {
+                        it = frac;
+                    }
+                }
+                if (!has_digits) {
+                    return false;
+                }
+
+                if (it != end && (*it == 'e' || *it == 'E')) {
+                    auto e = it + 1;
+                    bool exp_negative = false;
+                    if (e != end && (*e == '-' || *e == '+')) {
+                        exp_negative = *e == '-';
+                        ++e;
+                    }
+                    if (e != end && *e >= '0' && *e <= '9') {
+                        long exp = 0;
+                        for (; e != end && *e >= '0' && *e <= '9'; ++e) {
+                            if (exp < 100000) {
+                                exp = exp * 10 + (*e - '0');
+                            }
+                        }
+                        exp10 += exp_negative ? -exp : exp;
+                        it = e;
+                    }
+                }
+
+                if (mant == 0) {
+                    // Zero regardless of the exponent
+                    val = negative ? -detail::zero_value<T>::value
+                                   : detail::zero_value<T>::value;
+                    chars = static_cast<size_t>(it - str);
+                    return true;
+                }
+
+                if (std::numeric_limits<T>::digits < 64 &&
+                    (mant >> (std::numeric_limits<T>::digits % 64)) != 0) {
+                    return false;
+                }
+                static const int max_exp10 = max_exact_pow10<T>();
+                if (exp10 < -max_exp10 || exp10 > max_exp10) {
+                    return false;
+                }
+
+                T pow10 = 1;
+                for (long i = 0; i < (exp10 < 0 ? -exp10 : exp10); ++i) {
+                    pow10 *= 10;
+                }
+                T value = static_cast<T>(mant);
+                value = exp10 < 0 ? value / pow10 : value * pow10;
+                val = negative ? -value : value;
+                chars = static_cast<size_t>(it - str);
+                return true;
+            }
+        }  // namespace fast_path
+
         namespace fast_float {
             template <typename T>
             expected<T> impl(const char* str,
+                             std::size_t len,
                              size_t& chars,
                              uint8_t options,
                              char locale_decimal_point)
             {
-                const auto len = std::strlen(str);
                 if (((options & detail::float_scanner<T>::allow_hex) != 0) &&
                     is_hexfloat(str, len)) {
                     // fast_float doesn't support hexfloats
-                    return from_chars::read<T>::get(str, chars, options);
+                    return hexfloat::read<T>(str, len, chars, options,
+                                             locale_decimal_point);
                 }
 
                 T value{};
                 ::fast_float::parse_options flags{};
+                flags.decimal_point = locale_decimal_point;
                 if ((options & detail::float_scanner<T>::allow_fixed) != 0) {
                     flags.format = ::fast_float::fixed;
                 }
@@ -288,9 +777,6 @@ namespace scn {
                     flags.format = static_cast<::fast_float::chars_format>(
                         flags.format | ::fast_float::scientific);
                 }
-                if ((options & detail::float_scanner<T>::localized) != 0) {
-                    flags.decimal_point = locale_decimal_point;
-                }
 
                 const auto result = ::fast_float::from_chars_advanced(
                     str, str + len, value, flags);
@@ -306,7 +792,9 @@ namespace scn {
                     if (!(len >= 3 && (str[0] == 'i' || str[0] == 'I'))) {
                         // Input was not actually infinity ->
                         // invalid result, fall back to from_chars
-                        return from_chars::read<T>::get(str, chars, options);
+                        return from_chars::read<T>::get(str, len, chars,
+                                                        options,
+                                                        locale_decimal_point);
                     }
                 }
                 chars = static_cast<size_t>(result.ptr - str);
@@ -319,36 +807,70 @@ namespace scn {
             template <>
             struct read<float> {
                 static expected<float> get(const char* str,
+                                           std::size_t len,
                                            size_t& chars,
                                            uint8_t options,
                                            char locale_decimal_point)
                 {
-                    return impl<float>(str, chars, options,
+                    return impl<float>(str, len, chars, options,
                                        locale_decimal_point);
                 }
             };
             template <>
             struct read<double> {
                 static expected<double> get(const char* str,
+                                            std::size_t len,
                                             size_t& chars,
                                             uint8_t options,
                                             char locale_decimal_points)
                 {
-                    return impl<double>(str, chars, options,
+                    return impl<double>(str, len, chars, options,
                                         locale_decimal_points);
                 }
             };
             template <>
             struct read<long double> {
                 static expected<long double> get(const char* str,
+                                                 std::size_t len,
                                                  size_t& chars,
                                                  uint8_t options,
-                                                 char)
+                                                 char locale_decimal_point)
                 {
-                    // Fallback to strtod
                     // fast_float doesn't support long double
-                    return cstd::read<char, long double>::get(str, chars,
-                                                              options);
+                    using limits = std::numeric_limits<long double>;
+                    if (limits::digits ==
+                            std::numeric_limits<double>::digits &&
+                        limits::max_exponent ==
+                            std::numeric_limits<double>::max_exponent) {
+                        // long double is double: no need to fall back
+                        auto ret = impl<double>(str, len, chars, options,
+                                                locale_decimal_point);
+                        if (!ret) {
+                            return ret.error();
+                        }
+                        return static_cast<long double>(ret.value());
+                    }
+
+                    if (((options & detail::float_scanner<
+                                        long double>::allow_hex) != 0) &&
+                        is_hexfloat(str, len)) {
+                        return hexfloat::read<long double>(
+                            str, len, chars, options, locale_decimal_point);
+                    }
+
+                    const uint8_t general =
+                        detail::float_scanner<long double>::allow_fixed |
+                        detail::float_scanner<long double>::allow_scientific;
+                    long double value{};
+                    if ((options & general) == general &&
+                        fast_path::read(str, len, chars, locale_decimal_point,
+                                        value)) {
+                        return value;
+                    }
+
+                    // Fallback to strtod
+                    return cstd::read<char, long double>::get(
+                        str, len, chars, options, locale_decimal_point);
                 }
             };
         }  // namespace fast_float
@@ -359,6 +881,7 @@ namespace scn {
         template <typename T>
         struct read<char, T> {
             static expected<T> get(const char* str,
+                                   std::size_t len,
                                    size_t& chars,
                                    uint8_t options,
                                    char locale_decimal_points)
@@ -366,19 +889,37 @@ namespace scn {
                 // char -> default to fast_float,
                 // fallback to strtod if necessary
                 return read_float::fast_float::read<T>::get(
-                    str, chars, options, locale_decimal_points);
+                    str, len, chars, options, locale_decimal_points);
             }
         };
         template <typename T>
         struct read<wchar_t, T> {
             static expected<T> get(const wchar_t* str,
+                                   std::size_t len,
                                    size_t& chars,
                                    uint8_t options,
-                                   wchar_t)
+                                   wchar_t locale_decimal_point)
             {
-                // wchar_t -> straight to strtod
-                return read_float::cstd::read<wchar_t, T>::get(str, chars,
-                                                               options);
+                if (!is_ascii_code_point(
+                        make_code_point(locale_decimal_point))) {
+                    // Our parsers only take a char as the decimal point
+                    return read_float::cstd::read<wchar_t, T>::get(
+                        str, len, chars, options, locale_decimal_point);
+                }
+
+                // wchar_t -> narrow, and take the char path.
+                // A float is spelled in ASCII, so it ends before the first
+                // non-ASCII character, and every wchar_t maps to one char:
+                // chars is the same for both
+                detail::small_vector<char, 64> buf(len);
+                std::size_t n = 0;
+                for (; n < len && is_ascii_code_point(make_code_point(str[n]));
+                     ++n) {
+                    buf[n] = static_cast<char>(str[n]);
+                }
+                return read<char, T>::get(
+                    buf.data(), n, chars, options,
+                    static_cast<char>(locale_decimal_point));
             }
         };
     }  // namespace read_float
@@ -387,43 +928,54 @@ namespace scn {
         template <typename T>
         template <typename CharT>
         expected<T> float_scanner<T>::_read_float_impl(
-            const CharT* str,
+            span<const CharT> s,
             size_t& chars,
             CharT locale_decimal_point)
         {
             // Parsing algorithm to use:
-            // If CharT == wchar_t -> strtod
+            // If CharT == wchar_t -> narrow to char, and continue as below
+            //   (straight to std::wcstod if the locale decimal point is
+            //   not ASCII)
             // If CharT == char:
+            //   0. hexfloat::read for hexfloats,
+            //      fast_path::read for long double
+            //   All of these take the decimal point of the locale
+            //   (std::from_chars doesn't: it's skipped for anything but '.')
             //   1. fast_float
-            //      fallback if a hex float, or incorrectly parsed an inf
+            //      fallback if incorrectly parsed an inf
             //      (very large or small value)
             //   2. std::from_chars
             //      fallback if not available (C++17) or float is subnormal
             //   3. std::strtod
-            return read_float::read<CharT, T>::get(str, chars, format_options,
+            return read_float::read<CharT, T>::get(s.data(), s.size(), chars,
+                                                   format_options,
                                                    locale_decimal_point);
         }
 
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
 
-        template expected<float>
-        float_scanner<float>::_read_float_impl(const char*, size_t&, char);
-        template expected<double>
-        float_scanner<double>::_read_float_impl(const char*, size_t&, char);
+        template expected<float> float_scanner<float>::_read_float_impl(
+            span<const char>,
+            size_t&,
+            char);
+        template expected<double> float_scanner<double>::_read_float_impl(
+            span<const char>,
+            size_t&,
+            char);
         template expected<long double>
-        float_scanner<long double>::_read_float_impl(const char*,
+        float_scanner<long double>::_read_float_impl(span<const char>,
                                                      size_t&,
                                                      char);
         template expected<float> float_scanner<float>::_read_float_impl(
-            const wchar_t*,
+            span<const wchar_t>,
             size_t&,
             wchar_t);
         template expected<double> float_scanner<double>::_read_float_impl(
-            const wchar_t*,
+            span<const wchar_t>,
             size_t&,
             wchar_t);
         template expected<long double>
-        float_scanner<long double>::_read_float_impl(const wchar_t*,
+        float_scanner<long double>::_read_float_impl(span<const wchar_t>,
                                                      size_t&,
                                                      wchar_t);
 #endif
@@ -22,6 +22,12 @@
 #include <scn/detail/args.h>
 #include <scn/reader/int.h>
 
+#include <cstring>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -51,16 +57,280 @@ namespace scn {
                 255, 255, 255, 255, 255, 255, 255, 255, 255};
             return digits_arr[static_cast<unsigned char>(ch)];
         }
+        // Narrow ch to ASCII, mapping everything else to 0xff, which is
+        // neither a digit nor a letter; compiles to a conditional move
+        SCN_NODISCARD static unsigned char _narrow_ascii(wchar_t ch)
+        {
+            const auto u =
+                static_cast<typename std::make_unsigned<wchar_t>::type>(ch);
+            return u < 0x80 ? static_cast<unsigned char>(u) : 0xff;
+        }
         SCN_NODISCARD static unsigned char _char_to_int(wchar_t ch)
         {
-            SCN_GCC_PUSH
-            SCN_GCC_IGNORE("-Wconversion")
-            if (ch >= std::numeric_limits<char>::min() &&
-                ch <= std::numeric_limits<char>::max()) {
-                return _char_to_int(static_cast<char>(ch));
+            return _char_to_int(static_cast<char>(_narrow_ascii(ch)));
+        }
+
+        // Decimal fast path: eight (or with SSE4.1, sixteen) ASCII digits
+        // are classified and converted at once, see
+        // https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+        // Wide characters are narrowed to bytes when loaded, so that the
+        // rest of the fast path is shared with char.
+
+        SCN_NODISCARD static uint64_t _load_eight_chars(const char* p)
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            v = ((v & 0x00000000ffffffffull) << 32) |
+                ((v & 0xffffffff00000000ull) >> 32);
+            v = ((v & 0x0000ffff0000ffffull) << 16) |
+                ((v & 0xffff0000ffff0000ull) >> 16);
+            v = ((v & 0x00ff00ff00ff00ffull) << 8) |
+                ((v & 0xff00ff00ff00ff00ull) >> 8);
+#endif
+            return v;
+        }
+        SCN_NODISCARD static uint64_t _load_eight_chars(const wchar_t* p)
+        {
+            uint64_t v = 0;
+            for (int i = 0; i != 8; ++i) {
+                v |= static_cast<uint64_t>(_narrow_ascii(p[i])) << (i * 8);
             }
-            return 255;
-            SCN_GCC_POP
+            return v;
+        }
+        SCN_NODISCARD static bool _is_eight_digits(uint64_t v)
+        {
+            return ((v & 0xf0f0f0f0f0f0f0f0ull) |
+                    (((v + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >>
+                     4)) == 0x3333333333333333ull;
+        }
+        SCN_NODISCARD static uint32_t _parse_eight_digits(uint64_t v)
+        {
+            const uint64_t mask = 0x000000ff000000ffull;
+            const uint64_t mul1 = 0x000f424000000064ull;  // 100 + (1e6 << 32)
+            const uint64_t mul2 = 0x0000271000000001ull;  // 1 + (1e4 << 32)
+            v -= 0x3030303030303030ull;
+            v = (v * 10) + (v >> 8);
+            v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+            return static_cast<uint32_t>(v);
+        }
+
+#if defined(__SSE4_1__)
+        SCN_NODISCARD static __m128i _load_sixteen_values(const char* p)
+        {
+            return _mm_sub_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                _mm_set1_epi8('0'));
+        }
+        SCN_NODISCARD static __m128i _load_sixteen_values(const wchar_t* p)
+        {
+            // Unsigned saturation maps every code unit that is not ASCII
+            // to 0 or 0xff, neither of which is a digit
+            const auto q = reinterpret_cast<const __m128i*>(p);
+            __m128i bytes;
+            if (sizeof(wchar_t) == 2) {
+                bytes = _mm_packus_epi16(_mm_loadu_si128(q),
+                                         _mm_loadu_si128(q + 1));
+            }
+            else {
+                bytes = _mm_packus_epi16(
+                    _mm_packus_epi32(_mm_loadu_si128(q),
+                                     _mm_loadu_si128(q + 1)),
+                    _mm_packus_epi32(_mm_loadu_si128(q + 2),
+                                     _mm_loadu_si128(q + 3)));
+            }
+            return _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+        }
+        // Number of leading decimal digits in p[0, 16)
+        template <typename CharT>
+        SCN_NODISCARD static int _count_sixteen_digits(const CharT* p)
+        {
+            const auto nine = _mm_set1_epi8(9);
+            const auto chunk = _load_sixteen_values(p);
+            const auto digits = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_max_epu8(chunk, nine), nine)));
+            return __builtin_ctz(~digits);
+        }
+        template <typename CharT>
+        SCN_NODISCARD static uint64_t _parse_sixteen_digits(const CharT* p)
+        {
+            // 16 x 1 digit -> 8 x 2 digits -> 4 x 4 digits -> 2 x 8 digits
+            auto v = _mm_maddubs_epi16(
+                _load_sixteen_values(p),
+                _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+                              10, 1));
+            v = _mm_madd_epi16(
+                v, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+            v = _mm_packus_epi32(v, v);
+            v = _mm_madd_epi16(
+                v, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+            const auto hi = static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+            const auto lo = static_cast<uint32_t>(_mm_extract_epi32(v, 1));
+            return static_cast<uint64_t>(hi) * 100000000u + lo;
+        }
+#endif
+
+        /// Find the end of the run of decimal digits starting at it
+        template <typename CharT>
+        SCN_NODISCARD static const CharT* _find_decimal_end(const CharT* it,
+                                                            const CharT* end)
+        {
+#if defined(__SSE4_1__)
+            while (end - it >= 16) {
+                const auto n = _count_sixteen_digits(it);
+                it += n;
+                if (n != 16) {
+                    return it;
+                }
+            }
+#endif
+            while (end - it >= 8 && _is_eight_digits(_load_eight_chars(it))) {
+                it += 8;
+            }
+            while (it != end && _char_to_int(*it) < 10) {
+                ++it;
+            }
+            return it;
+        }
+
+        /// At least 64 bits wide, so that a block fits in without overflow
+        template <typename U>
+        using wide_uint_t =
+            typename std::conditional<(sizeof(U) > sizeof(uint64_t)),
+                                      U,
+                                      uint64_t>::type;
+
+        /**
+         * Accumulate whole blocks of digits from [it, end) into tmp.
+         * Every character in the range must be a decimal digit, and there
+         * must be few enough of them for tmp not to overflow.
+         * Returns the position of the first unconsumed digit.
+         */
+        template <typename CharT, typename U>
+        static const CharT* _parse_decimal_blocks(const CharT* it,
+                                                  const CharT* end,
+                                                  U& tmp)
+        {
+#if defined(__SSE4_1__)
+            while (end - it >= 16) {
+                tmp = static_cast<U>(static_cast<wide_uint_t<U>>(tmp) *
+                                         10000000000000000ull +
+                                     _parse_sixteen_digits(it));
+                it += 16;
+            }
+#endif
+            while (end - it >= 8) {
+                tmp = static_cast<U>(
+                    static_cast<wide_uint_t<U>>(tmp) * 100000000u +
+                    _parse_eight_digits(_load_eight_chars(it)));
+                it += 8;
+            }
+            return it;
+        }
+
+        // Power-of-two bases: digits are accumulated with shifts, and
+        // hexadecimal digits are decoded eight at a time
+
+        // High bit set in every byte of v that lies in (lo, hi)
+        SCN_NODISCARD static uint64_t _bytes_between(uint64_t v,
+                                                     uint64_t lo,
+                                                     uint64_t hi)
+        {
+            const uint64_t ones = 0x0101010101010101ull;
+            const uint64_t low7 = v & (ones * 127);
+            return (ones * (127 + hi) - low7) & ~v &
+                   (low7 + ones * (127 - lo)) & (ones * 128);
+        }
+        SCN_NODISCARD static bool _is_eight_hex_digits(uint64_t v)
+        {
+            return (_bytes_between(v, 0x2f, 0x3a) |
+                    _bytes_between(v | 0x2020202020202020ull, 0x60, 0x67)) ==
+                   0x8080808080808080ull;
+        }
+        SCN_NODISCARD static uint32_t _parse_eight_hex_digits(uint64_t v)
+        {
+            // nibble values: low four bits, plus 9 for letters
+            v = (v & 0x0f0f0f0f0f0f0f0full) +
+                ((v & 0x4040404040404040ull) >> 6) * 9;
+            // 8 x 4 bits -> 4 x 8 bits -> 2 x 16 bits -> 32 bits
+            v = ((v & 0x000f000f000f000full) << 4) |
+                ((v >> 8) & 0x000f000f000f000full);
+            v = ((v & 0x000000ff000000ffull) << 8) |
+                ((v >> 16) & 0x000000ff000000ffull);
+            v = ((v & 0xffffull) << 16) | ((v >> 32) & 0xffffull);
+            return static_cast<uint32_t>(v);
+        }
+
+        /// Find the end of the run of digits in any base starting at it,
+        /// checking eight characters at a time in base 16
+        template <typename CharT>
+        SCN_NODISCARD static const CharT* _find_digits_end(
+            const CharT* it,
+            const CharT* end,
+            unsigned base)
+        {
+            if (base == 16) {
+                while (end - it >= 8 &&
+                       _is_eight_hex_digits(_load_eight_chars(it))) {
+                    it += 8;
+                }
+            }
+            while (it != end && _char_to_int(*it) < base) {
+                ++it;
+            }
+            return it;
+        }
+
+        /**
+         * Accumulate whole blocks of hexadecimal digits from [it, end)
+         * into tmp. Every character in the range must be a hex digit,
+         * and there must be few enough of them for tmp not to overflow.
+         */
+        template <typename CharT, typename U>
+        static const CharT* _parse_hex_blocks(const CharT* it,
+                                              const CharT* end,
+                                              U& tmp)
+        {
+            while (end - it >= 8) {
+                tmp = static_cast<U>(
+                    (static_cast<wide_uint_t<U>>(tmp) << 32) |
+                    _parse_eight_hex_digits(_load_eight_chars(it)));
+                it += 8;
+            }
+            return it;
+        }
+
+        /**
+         * Accumulate the decimal digits in [it, end) into tmp, up to 19
+         * at a time in a 64-bit register, so that wider types only need a
+         * single wide multiplication per chunk.
+         * There must be few enough digits for tmp not to overflow.
+         */
+        template <typename U, typename CharT>
+        static U _accumulate_decimal(const CharT* it, const CharT* end, U tmp)
+        {
+            while (it != end) {
+                const auto chunk_end = end - it > 19 ? it + 19 : end;
+                uint64_t chunk = 0;
+                uint64_t scale = 1;
+                for (; it != chunk_end; ++it) {
+                    chunk = chunk * 10 + _char_to_int(*it);
+                    scale *= 10;
+                }
+                tmp = static_cast<U>(static_cast<wide_uint_t<U>>(tmp) * scale +
+                                     chunk);
+            }
+            return tmp;
+        }
+
+        SCN_NODISCARD static int _bit_width(unsigned v)
+        {
+            int n = 0;
+            for (; v != 0; v >>= 1) {
+                ++n;
+            }
+            return n;
         }
 
         template <typename T>
@@ -151,7 +421,8 @@ namespace scn {
         template <typename CharT>
         expected<std::ptrdiff_t> integer_scanner<T>::_parse_int(
             T& val,
-            span<const CharT> s)
+            span<const CharT> s,
+            CharT thsep)
         {
             SCN_EXPECT(s.size() > 0);
 
@@ -159,7 +430,7 @@ namespace scn {
             SCN_MSVC_IGNORE(4244)
             SCN_MSVC_IGNORE(4127)  // conditional expression is constant
 
-            if (std::is_unsigned<T>::value) {
+            if (!int_traits<T>::is_signed) {
                 if (s[0] == detail::ascii_widen<CharT>('-')) {
                     return error(error::invalid_scanned_value,
                                  "Unexpected sign '-' when scanning an "
@@ -231,7 +502,12 @@ namespace scn {
             SCN_ASSUME(base > 0);
 
             SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-            auto r = _parse_int_impl(tmp, minus_sign, make_span(it, s.end()));
+            auto r =
+                SCN_UNLIKELY((format_options & allow_thsep) != 0 &&
+                             thsep != CharT{})
+                    ? _parse_int_grouped(tmp, minus_sign,
+                                         make_span(it, s.end()), thsep)
+                    : _parse_int_impl(tmp, minus_sign, make_span(it, s.end()));
             SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
             if (!r) {
                 return r.error();
@@ -247,12 +523,232 @@ namespace scn {
             SCN_GCC_POP
         }
 
+        /// Largest absolute value a T can be parsed into
+        template <typename T>
+        SCN_CONSTEXPR14 typename int_traits<T>::unsigned_type _int_limit(
+            bool minus_sign)
+        {
+            using utype = typename int_traits<T>::unsigned_type;
+            constexpr auto uint_max = static_cast<utype>(-1);
+            constexpr auto int_max = static_cast<utype>(uint_max >> 1);
+            if (int_traits<T>::is_signed) {
+                if (minus_sign) {
+                    return static_cast<utype>(int_max + 1);
+                }
+                return int_max;
+            }
+            return uint_max;
+        }
+
+        template <typename T>
+        static void _store_int(T& val,
+                               typename int_traits<T>::unsigned_type tmp,
+                               bool minus_sign)
+        {
+            SCN_GCC_PUSH
+            SCN_GCC_IGNORE("-Wconversion")
+            SCN_GCC_IGNORE("-Wsign-conversion")
+
+            SCN_CLANG_PUSH
+            SCN_CLANG_IGNORE("-Wconversion")
+            SCN_CLANG_IGNORE("-Wsign-conversion")
+
+            SCN_MSVC_PUSH
+            SCN_MSVC_IGNORE(4244)  // lossy conversion
+
+            if (minus_sign) {
+                // special case: signed int minimum's absolute value can't
+                // be represented with the same type
+                //
+                // For example, short int -- range is [-32768, 32767], 32768
+                // can't be represented
+                //
+                // In that case, -static_cast<T>(tmp) would trigger UB
+                if (SCN_UNLIKELY(tmp == _int_limit<T>(true) &&
+                                 int_traits<T>::is_signed)) {
+                    val = int_traits<T>::min();
+                }
+                else {
+                    val = -static_cast<T>(tmp);
+                }
+            }
+            else {
+                val = static_cast<T>(tmp);
+            }
+
+            SCN_MSVC_POP
+            SCN_CLANG_POP
+            SCN_GCC_POP
+        }
+
+        static inline error _int_out_of_range(bool minus_sign)
+        {
+            if (!minus_sign) {
+                return error(error::value_out_of_range,
+                             "Out of range: integer overflow");
+            }
+            return error(error::value_out_of_range,
+                         "Out of range: integer underflow");
+        }
+
+        template <unsigned Base>
+        using static_int_base = std::integral_constant<unsigned, Base>;
+        struct dynamic_int_base {
+            unsigned value;
+        };
+
+        /**
+         * Base-independent part of integer_scanner::_parse_int_impl.
+         * Base is either static_int_base, for which the range checks and
+         * arithmetic get folded at compile time, or dynamic_int_base.
+         */
+        template <typename T, typename CharT, typename Base>
+        static expected<typename span<const CharT>::iterator>
+        _parse_int_digits(T& val,
+                          bool minus_sign,
+                          span<const CharT> buf,
+                          Base b)
+        {
+            SCN_GCC_PUSH
+            SCN_GCC_IGNORE("-Wconversion")
+            SCN_GCC_IGNORE("-Wsign-conversion")
+            SCN_GCC_IGNORE("-Wsign-compare")
+
+            SCN_CLANG_PUSH
+            SCN_CLANG_IGNORE("-Wconversion")
+            SCN_CLANG_IGNORE("-Wsign-conversion")
+            SCN_CLANG_IGNORE("-Wsign-compare")
+
+            SCN_MSVC_PUSH
+            SCN_MSVC_IGNORE(4018)  // > signed/unsigned mismatch
+            SCN_MSVC_IGNORE(4389)  // == signed/unsigned mismatch
+            SCN_MSVC_IGNORE(4244)  // lossy conversion
+
+            using utype = typename int_traits<T>::unsigned_type;
+
+            const auto ubase = static_cast<utype>(b.value);
+            SCN_ASSUME(ubase > 0);
+
+            const auto limit = _int_limit<T>(minus_sign);
+            const auto cut = div(limit, ubase);
+            const auto cutoff = cut.first;
+            const auto cutlim = cut.second;
+
+            auto it = buf.begin();
+            const auto end = buf.end();
+            utype tmp = 0;
+            if (ubase == 10) {
+                // Any run of at most digits10 digits fits into T,
+                // and the largest value has one digit more than that,
+                // so only a maximum-length run needs an overflow check.
+                constexpr auto max_digits = int_traits<T>::digits10;
+
+                while (it != end && *it == ascii_widen<CharT>('0')) {
+                    ++it;
+                }
+                const auto digits_end = _find_decimal_end(it, end);
+                const auto n = digits_end - it;
+                if (SCN_UNLIKELY(n > max_digits + 1)) {
+                    return _int_out_of_range(minus_sign);
+                }
+
+                const auto unchecked_end =
+                    n > max_digits ? it + max_digits : digits_end;
+                it = _parse_decimal_blocks(it, unchecked_end, tmp);
+                tmp = _accumulate_decimal(it, unchecked_end, tmp);
+                it = unchecked_end;
+                if (it != digits_end) {
+                    const auto digit = _char_to_int(*it);
+                    if (SCN_UNLIKELY(tmp > cutoff ||
+                                     (tmp == cutoff && digit > cutlim))) {
+                        return _int_out_of_range(minus_sign);
+                    }
+                    tmp = tmp * 10 + digit;
+                    ++it;
+                }
+            }
+            else if ((ubase & (ubase - 1)) == 0) {
+                // The value fits into utype if its significant bits do,
+                // so the range is checked only once, at the end.
+                const auto shift = _bit_width(ubase) - 1;
+
+                while (it != end && *it == ascii_widen<CharT>('0')) {
+                    ++it;
+                }
+                const auto digits_end = _find_digits_end(it, end, ubase);
+                if (it != digits_end) {
+                    const auto bits = (digits_end - it - 1) * shift +
+                                      _bit_width(_char_to_int(*it));
+                    if (SCN_UNLIKELY(bits >
+                                     int_traits<T>::unsigned_digits)) {
+                        return _int_out_of_range(minus_sign);
+                    }
+
+                    if (ubase == 16) {
+                        it = _parse_hex_blocks(it, digits_end, tmp);
+                    }
+                    for (; it != digits_end; ++it) {
+                        tmp = (tmp << shift) | _char_to_int(*it);
+                    }
+                    if (SCN_UNLIKELY(tmp > limit)) {
+                        return _int_out_of_range(minus_sign);
+                    }
+                }
+            }
+            else {
+                for (; it != end; ++it) {
+                    const auto digit = _char_to_int(*it);
+                    if (digit >= ubase) {
+                        break;
+                    }
+                    if (SCN_UNLIKELY(tmp > cutoff ||
+                                     (tmp == cutoff && digit > cutlim))) {
+                        return _int_out_of_range(minus_sign);
+                    }
+                    tmp = tmp * ubase + digit;
+                }
+            }
+            _store_int(val, tmp, minus_sign);
+            return it;
+
+            SCN_MSVC_POP
+            SCN_CLANG_POP
+            SCN_GCC_POP
+        }
+
         template <typename T>
         template <typename CharT>
         expected<typename span<const CharT>::iterator>
         integer_scanner<T>::_parse_int_impl(T& val,
                                             bool minus_sign,
                                             span<const CharT> buf) const
+        {
+            switch (base) {
+                case 10:
+                    return _parse_int_digits(val, minus_sign, buf,
+                                             static_int_base<10>{});
+                case 16:
+                    return _parse_int_digits(val, minus_sign, buf,
+                                             static_int_base<16>{});
+                case 8:
+                    return _parse_int_digits(val, minus_sign, buf,
+                                             static_int_base<8>{});
+                case 2:
+                    return _parse_int_digits(val, minus_sign, buf,
+                                             static_int_base<2>{});
+                default:
+                    return _parse_int_digits(val, minus_sign, buf,
+                                             dynamic_int_base{base});
+            }
+        }
+
+        template <typename T>
+        template <typename CharT>
+        expected<typename span<const CharT>::iterator>
+        integer_scanner<T>::_parse_int_grouped(T& val,
+                                               bool minus_sign,
+                                               span<const CharT> buf,
+                                               CharT thsep) const
         {
             SCN_GCC_PUSH
             SCN_GCC_IGNORE("-Wconversion")
@@ -266,70 +762,172 @@ namespace scn {
 
             SCN_MSVC_PUSH
             SCN_MSVC_IGNORE(4018)  // > signed/unsigned mismatch
-            SCN_MSVC_IGNORE(4389)  // == signed/unsigned mismatch
             SCN_MSVC_IGNORE(4244)  // lossy conversion
 
-            using utype = typename std::make_unsigned<T>::type;
+            using utype = typename int_traits<T>::unsigned_type;
 
             const auto ubase = static_cast<utype>(base);
-            SCN_ASSUME(ubase > 0);
-
-            constexpr auto uint_max = static_cast<utype>(-1);
-            constexpr auto int_max = static_cast<utype>(uint_max >> 1);
-            constexpr auto abs_int_min = static_cast<utype>(int_max + 1);
-
-            const auto cut = div(
-                [&]() -> utype {
-                    if (std::is_signed<T>::value) {
-                        if (minus_sign) {
-                            return abs_int_min;
-                        }
-                        return int_max;
-                    }
-                    return uint_max;
-                }(),
-                ubase);
+            const auto cut = div(_int_limit<T>(minus_sign), ubase);
             const auto cutoff = cut.first;
             const auto cutlim = cut.second;
 
+            // The digits between separators are parsed run by run, with
+            // the block kernels for as long as the value can't overflow
             auto it = buf.begin();
             const auto end = buf.end();
+            auto digits_end = it;
             utype tmp = 0;
-            for (; it != end; ++it) {
-                const auto digit = _char_to_int(*it);
-                if (digit >= ubase) {
+            std::ptrdiff_t significant = 0;
+            while (true) {
+                const auto run_end = ubase == 10
+                                         ? _find_decimal_end(it, end)
+                                         : _find_digits_end(it, end, base);
+                if (it == run_end) {
                     break;
                 }
-                if (SCN_UNLIKELY(tmp > cutoff ||
-                                 (tmp == cutoff && digit > cutlim))) {
-                    if (!minus_sign) {
-                        return error(error::value_out_of_range,
-                                     "Out of range: integer overflow");
+                if (ubase == 10) {
+                    if (tmp == 0) {
+                        while (it != run_end &&
+                               *it == ascii_widen<CharT>('0')) {
+                            ++it;
+                        }
+                    }
+                    if (significant + (run_end - it) <=
+                        int_traits<T>::digits10) {
+                        significant += run_end - it;
+                        it = _parse_decimal_blocks(it, run_end, tmp);
+                        tmp = _accumulate_decimal(it, run_end, tmp);
+                        it = run_end;
                     }
-                    return error(error::value_out_of_range,
-                                 "Out of range: integer underflow");
                 }
-                tmp = tmp * ubase + digit;
+                for (; it != run_end; ++it) {
+                    const auto digit = _char_to_int(*it);
+                    if (SCN_UNLIKELY(tmp > cutoff ||
+                                     (tmp == cutoff && digit > cutlim))) {
+                        return _int_out_of_range(minus_sign);
+                    }
+                    tmp = tmp * ubase + digit;
+                    ++significant;
+                }
+                digits_end = it;
+
+                // A separator only belongs to the number
+                // if there's a digit after it
+                if (it == end || *it != thsep || it + 1 == end ||
+                    _char_to_int(*(it + 1)) >= ubase) {
+                    break;
+                }
+                ++it;
             }
-            if (minus_sign) {
-                // special case: signed int minimum's absolute value can't
-                // be represented with the same type
-                //
-                // For example, short int -- range is [-32768, 32767], 32768
-                // can't be represented
-                //
-                // In that case, -static_cast<T>(tmp) would trigger UB
-                if (SCN_UNLIKELY(tmp == abs_int_min)) {
-                    val = std::numeric_limits<T>::min();
+            _store_int(val, tmp, minus_sign);
+            return digits_end;
+
+            SCN_MSVC_POP
+            SCN_CLANG_POP
+            SCN_GCC_POP
+        }
+
+        template <typename T>
+        template <typename CharT>
+        expected<std::ptrdiff_t> integer_scanner<T>::_parse_int_localized(
+            T& val,
+            span<const CharT> s,
+            CharT thsep,
+            string_view grouping) const
+        {
+            SCN_GCC_PUSH
+            SCN_GCC_IGNORE("-Wconversion")
+            SCN_GCC_IGNORE("-Wsign-conversion")
+            SCN_GCC_IGNORE("-Wsign-compare")
+
+            SCN_CLANG_PUSH
+            SCN_CLANG_IGNORE("-Wconversion")
+            SCN_CLANG_IGNORE("-Wsign-conversion")
+            SCN_CLANG_IGNORE("-Wsign-compare")
+
+            SCN_MSVC_PUSH
+            SCN_MSVC_IGNORE(4018)  // > signed/unsigned mismatch
+            SCN_MSVC_IGNORE(4127)  // conditional expression is constant
+            SCN_MSVC_IGNORE(4244)  // lossy conversion
+
+            using utype = typename int_traits<T>::unsigned_type;
+
+            auto it = s.begin();
+            const auto end = s.end();
+            bool minus_sign = false;
+            if (it != end && *it == ascii_widen<CharT>('-')) {
+                if (!int_traits<T>::is_signed ||
+                    (format_options & only_unsigned) != 0) {
+                    return error(error::invalid_scanned_value,
+                                 "Parsed negative value when type was 'u'");
                 }
-                else {
-                    val = -static_cast<T>(tmp);
+                minus_sign = true;
+                ++it;
+            }
+            else if (it != end && *it == ascii_widen<CharT>('+')) {
+                ++it;
+            }
+
+            const auto ubase = static_cast<utype>(base);
+            auto is_digit = [&](CharT ch) { return _char_to_int(ch) < ubase; };
+
+            // A thousands separator is only a part of the number
+            // if the locale groups digits, and it's surrounded by digits
+            const bool grouped =
+                grouping.size() != 0 && grouping[0] > 0 &&
+                grouping[0] != std::numeric_limits<char>::max();
+            const auto digits_begin = it;
+            bool has_thsep = false;
+            for (; it != end; ++it) {
+                if (is_digit(*it)) {
+                    continue;
+                }
+                if (grouped && *it == thsep && it != digits_begin &&
+                    it + 1 != end && is_digit(*(it + 1))) {
+                    has_thsep = true;
+                    continue;
                 }
+                break;
             }
-            else {
-                val = static_cast<T>(tmp);
+            const auto digits_end = it;
+            if (digits_begin == digits_end) {
+                return error(error::invalid_scanned_value,
+                             "Expected digits after sign");
             }
-            return it;
+
+            if (!has_thsep) {
+                auto r = _parse_int_impl(val, minus_sign,
+                                         make_span(digits_begin, digits_end));
+                if (!r) {
+                    return r.error();
+                }
+                return ranges::distance(s.begin(), r.value());
+            }
+
+            auto e = check_digit_grouping(
+                make_span(digits_begin, digits_end), thsep, grouping);
+            if (!e) {
+                return e;
+            }
+
+            const auto cut = div(_int_limit<T>(minus_sign), ubase);
+            const auto cutoff = cut.first;
+            const auto cutlim = cut.second;
+
+            utype tmp = 0;
+            for (it = digits_begin; it != digits_end; ++it) {
+                if (*it == thsep) {
+                    continue;
+                }
+                const auto digit = _char_to_int(*it);
+                if (SCN_UNLIKELY(tmp > cutoff ||
+                                 (tmp == cutoff && digit > cutlim))) {
+                    return _int_out_of_range(minus_sign);
+                }
+                tmp = tmp * ubase + digit;
+            }
+            _store_int(val, tmp, minus_sign);
+            return ranges::distance(s.begin(), digits_end);
 
             SCN_MSVC_POP
             SCN_CLANG_POP
@@ -338,14 +936,23 @@ namespace scn {
 
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
 
-#define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(CharT, T)             \
-    template expected<std::ptrdiff_t> integer_scanner<T>::_parse_int( \
-        T& val, span<const CharT> s);                                 \
-    template expected<typename span<const CharT>::iterator>           \
-    integer_scanner<T>::_parse_int_impl(T& val, bool minus_sign,      \
-                                        span<const CharT> buf) const; \
-    template expected<typename span<const CharT>::iterator>           \
-    integer_scanner<T>::parse_base_prefix(span<const CharT>, int&) const;
+#define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(CharT, T)              \
+    template expected<std::ptrdiff_t> integer_scanner<T>::_parse_int(  \
+        T& val, span<const CharT> s, CharT thsep);                     \
+    template expected<typename span<const CharT>::iterator>            \
+    integer_scanner<T>::_parse_int_impl(T& val, bool minus_sign,       \
+                                        span<const CharT> buf) const;  \
+    template expected<typename span<const CharT>::iterator>            \
+    integer_scanner<T>::_parse_int_grouped(                            \
+        T& val, bool minus_sign, span<const CharT> buf, CharT thsep)   \
+        const;                                                         \
+    template expected<typename span<const CharT>::iterator>            \
+    integer_scanner<T>::parse_base_prefix(span<const CharT>, int&)     \
+        const;                                                         \
+    template expected<std::ptrdiff_t>                                  \
+    integer_scanner<T>::_parse_int_localized(                          \
+        T& val, span<const CharT> s, CharT thsep, string_view grouping) \
+        const;
 
 #define SCN_DEFINE_INTEGER_SCANNER_MEMBERS(Char)                      \
     SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, signed char)        \
@@ -364,6 +971,13 @@ namespace scn {
         SCN_DEFINE_INTEGER_SCANNER_MEMBERS(char)
         SCN_DEFINE_INTEGER_SCANNER_MEMBERS(wchar_t)
 
+#if SCN_HAS_INT128
+        SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(char, int128)
+        SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(char, uint128)
+        SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(wchar_t, int128)
+        SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(wchar_t, uint128)
+#endif
+
 #endif
 
     }  // namespace detail
@@ -0,0 +1,179 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <cstdint>
+
+using money = scn::decimal<std::int64_t, 4>;
+
+TEST_CASE_TEMPLATE("decimal", CharT, char, wchar_t)
+{
+    money d{};
+    auto e = do_scan<CharT>("123.4567", "{}", d);
+    CHECK(e);
+    CHECK(d.value == 1234567);
+
+    e = do_scan<CharT>("-0.5", "{}", d);
+    CHECK(e);
+    CHECK(d.value == -5000);
+
+    e = do_scan<CharT>("+42", "{}", d);
+    CHECK(e);
+    CHECK(d.value == 420000);
+
+    e = do_scan<CharT>("7.", "{}", d);
+    CHECK(e);
+    CHECK(d.value == 70000);
+
+    e = do_scan<CharT>(".25", "{}", d);
+    CHECK(e);
+    CHECK(d.value == 2500);
+
+    e = do_scan<CharT>("000001.0001", "{}", d);
+    CHECK(e);
+    CHECK(d.value == 10001);
+
+    d.value = 1;
+    e = do_scan<CharT>(".", "{}", d);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::invalid_scanned_value);
+    CHECK(d.value == 1);
+
+    e = do_scan<CharT>("-x", "{}", d);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::invalid_scanned_value);
+}
+
+TEST_CASE("decimal trailing characters")
+{
+    money d{};
+    std::string s{};
+    auto e = scn::scan("12.5e3 foo", "{}{}", d, s);
+    CHECK(e);
+    CHECK(d.value == 125000);
+    CHECK(s == "e3");
+
+    e = scn::scan("1.5.5", "{}{}", d, s);
+    CHECK(e);
+    CHECK(d.value == 15000);
+    CHECK(s == ".5");
+
+    auto source = get_deque<char>("3.14159 rest");
+    scn::decimal<int, 2, scn::decimal_rounding::truncate> pi{};
+    auto ret = scn::scan(source, "{}", pi);
+    CHECK(ret);
+    CHECK(pi.value == 314);
+}
+
+TEST_CASE("decimal rounding")
+{
+    SUBCASE("reject")
+    {
+        money d{};
+        auto e = scn::scan("1.23456", "{}", d);
+        CHECK(!e);
+        CHECK(e.error() == scn::error::invalid_scanned_value);
+
+        // trailing zeroes lose no precision
+        e = scn::scan("1.23450000", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 12345);
+    }
+    SUBCASE("truncate")
+    {
+        scn::decimal<int, 2, scn::decimal_rounding::truncate> d{};
+        auto e = scn::scan("1.999", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 199);
+        e = scn::scan("-1.999", "{}", d);
+        CHECK(e);
+        CHECK(d.value == -199);
+    }
+    SUBCASE("half_up")
+    {
+        scn::decimal<int, 2, scn::decimal_rounding::half_up> d{};
+        auto e = scn::scan("1.005", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 101);
+        e = scn::scan("-1.0049999", "{}", d);
+        CHECK(e);
+        CHECK(d.value == -100);
+        e = scn::scan("0.995", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 100);
+    }
+    SUBCASE("half_even")
+    {
+        scn::decimal<int, 2, scn::decimal_rounding::half_even> d{};
+        auto e = scn::scan("1.005", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 100);
+        e = scn::scan("1.015", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 102);
+        e = scn::scan("1.0050001", "{}", d);
+        CHECK(e);
+        CHECK(d.value == 101);
+
+        scn::decimal<int, 0, scn::decimal_rounding::half_even> i{};
+        e = scn::scan("2.5", "{}", i);
+        CHECK(e);
+        CHECK(i.value == 2);
+        e = scn::scan("3.5", "{}", i);
+        CHECK(e);
+        CHECK(i.value == 4);
+    }
+}
+
+TEST_CASE("decimal range")
+{
+    money d{};
+    auto e = scn::scan("922337203685477.5807", "{}", d);
+    CHECK(e);
+    CHECK(d.value == std::numeric_limits<std::int64_t>::max());
+
+    e = scn::scan("-922337203685477.5808", "{}", d);
+    CHECK(e);
+    CHECK(d.value == std::numeric_limits<std::int64_t>::min());
+
+    e = scn::scan("922337203685477.5808", "{}", d);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::value_out_of_range);
+
+    e = scn::scan("100000000000000000000", "{}", d);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::value_out_of_range);
+
+    // rounding up can overflow, too
+    scn::decimal<signed char, 1, scn::decimal_rounding::half_up> c{};
+    e = scn::scan("12.74", "{}", c);
+    CHECK(e);
+    CHECK(c.value == 127);
+    e = scn::scan("12.75", "{}", c);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::value_out_of_range);
+
+    scn::decimal<unsigned, 3> u{};
+    e = scn::scan("4294967.295", "{}", u);
+    CHECK(e);
+    CHECK(u.value == 4294967295u);
+    e = scn::scan("-1", "{}", u);
+    CHECK(!e);
+    CHECK(e.error() == scn::error::invalid_scanned_value);
+}
@@ -17,9 +17,18 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <scn/istream.h>
+#include <cstdlib>
 #include <istream>
 #include "../test.h"
 
+#if SCN_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <dirent.h>
+#endif
+
 static bool do_fgets(char* str, size_t count, std::FILE* f)
 {
     return std::fgets(str, static_cast<int>(count), f) != nullptr;
@@ -29,6 +38,100 @@ static bool do_fgets(wchar_t* str, size_t count, std::FILE* f)
     return std::fgetws(str, static_cast<int>(count), f) != nullptr;
 }
 
+// Temporary file containing the integers [0, n), one per line
+static std::FILE* make_int_file(int n)
+{
+    auto f = std::tmpfile();
+    if (f) {
+        for (int i = 0; i < n; ++i) {
+            std::fprintf(f, "%d\n", i);
+        }
+        std::rewind(f);
+    }
+    return f;
+}
+
+// Named temporary file in the temporary directory, containing the integers
+// [0, n), one per line, for the file types opened by name.
+// Removed on destruction, name() is empty on failure
+class temp_int_file {
+public:
+    explicit temp_int_file(int n)
+    {
+#if SCN_POSIX
+        const char* dir = std::getenv("TMPDIR");
+        m_name = std::string{dir && *dir ? dir : "/tmp"} + "/scn-test-XXXXXX";
+        int fd = ::mkstemp(&m_name[0]);
+        if (fd == -1) {
+            m_name.clear();
+            return;
+        }
+        auto f = ::fdopen(fd, "w");
+        if (!f) {
+            ::close(fd);
+        }
+#else
+        char buf[L_tmpnam];
+        if (!std::tmpnam(buf)) {
+            return;
+        }
+        m_name = buf;
+        auto f = std::fopen(buf, "w");
+#endif
+        if (!f) {
+            std::remove(m_name.c_str());
+            m_name.clear();
+            return;
+        }
+        for (int i = 0; i < n; ++i) {
+            std::fprintf(f, "%d\n", i);
+        }
+        std::fclose(f);
+    }
+
+    temp_int_file(const temp_int_file&) = delete;
+    temp_int_file& operator=(const temp_int_file&) = delete;
+
+    ~temp_int_file()
+    {
+        if (!m_name.empty()) {
+            std::remove(m_name.c_str());
+        }
+    }
+
+    const std::string& name() const
+    {
+        return m_name;
+    }
+
+private:
+    std::string m_name;
+};
+
+#if SCN_POSIX
+// Read end of a pipe containing the integers [0, n), separated by spaces,
+// with the write end closed; -1 on failure
+static int make_int_pipe(int n)
+{
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return -1;
+    }
+    std::string data;
+    for (int i = 0; i < n; ++i) {
+        data += std::to_string(i);
+        data += ' ';
+    }
+    const auto written = ::write(fds[1], data.data(), data.size());
+    ::close(fds[1]);
+    if (written != static_cast<ssize_t>(data.size())) {
+        ::close(fds[0]);
+        return -1;
+    }
+    return fds[0];
+}
+#endif
+
 TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
 {
     scn::basic_owning_file<CharT> file{"./test/file/testfile.txt", "r"};
@@ -81,7 +184,8 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
         CHECK(word == widen<CharT>("word"));
         file.sync();
 
-        word = widen<CharT>("another");
+        // the space after "word" was not consumed, and is put back
+        word = widen<CharT>(" another");
 
         std::vector<CharT> buf(word.size() + 1, 0);
         bool fgets_ret = do_fgets(buf.data(), buf.size(), file.handle());
@@ -151,6 +255,725 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
     }
 }
 
+TEST_CASE_TEMPLATE("file with block size", CharT, char, wchar_t)
+{
+    scn::basic_owning_file<CharT> file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+    file.set_block_size(4);
+    CHECK(file.block_size() == 4);
+
+    using string_type = std::basic_string<CharT>;
+
+    SUBCASE("entire file")
+    {
+        auto result = scn::make_result(file);
+
+        int i;
+        result = scn::scan_default(result.range(), i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        string_type word;
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("another"));
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+
+    SUBCASE("syncing")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+        file.sync();
+
+        string_type word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+        file.sync();
+
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("another"));
+    }
+
+    SUBCASE("error")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        result = scn::scan_default(result.range(), i);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+        file.sync();
+
+        string_type word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+    }
+
+    SUBCASE("getline")
+    {
+        string_type line;
+        auto result = scn::getline(file, line);
+        CHECK(result);
+        CHECK(line == widen<CharT>("123"));
+
+        result = scn::getline(result.range(), line);
+        CHECK(result);
+        CHECK(line == widen<CharT>("word another"));
+    }
+}
+
+TEST_CASE_TEMPLATE("file with window", CharT, char, wchar_t)
+{
+    scn::basic_owning_file<CharT> file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+    file.set_window_size(4);
+    CHECK(file.window_size() == 4);
+
+    using string_type = std::basic_string<CharT>;
+
+    SUBCASE("no syncing required")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        string_type word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("another"));
+
+        result = scn::scan_default(file, word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+
+    SUBCASE("error")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        result = scn::scan_default(file, i);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+        string_type word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+    }
+
+    SUBCASE("syncing")
+    {
+        file.set_block_size(8);
+
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        string_type word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+        file.sync();
+
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("another"));
+    }
+}
+
+TEST_CASE("file with window, resetting begin iterator")
+{
+    auto f = make_int_file(1000);
+    REQUIRE(f);
+    scn::owning_file file{f};
+    file.set_block_size(8);
+    file.set_window_size(16);
+
+    int i{}, expected{0};
+    auto result = scn::make_result(file);
+    for (; expected < 101; ++expected) {
+        result = scn::scan_default(result.range(), i);
+        CHECK(result);
+        CHECK(i == expected);
+    }
+
+    // the buffer has been shifted: begin() isn't at position 0 anymore
+    result.range().reset_begin_iterator();
+    result = scn::scan_default(result.range(), i);
+    CHECK(result);
+    CHECK(i == expected);
+}
+
+#if SCN_POSIX
+TEST_CASE("file with block size, mixing with cstdio")
+{
+    scn::owning_file file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+    file.set_block_size(64);
+
+    int i;
+    auto result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.sync();
+
+    // seeked back to right after "123"
+    char buf[16] = {0};
+    CHECK(std::fscanf(file.handle(), "%15s", buf) == 1);
+    CHECK(std::string{buf} == "word");
+
+    std::string word;
+    result = scn::scan_default(file, word);
+    CHECK(result);
+    CHECK(word == "another");
+}
+#endif
+
+TEST_CASE("file handoff")
+{
+    scn::owning_wfile file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+
+    {
+        // wide streams can't be seeked, so the characters left over are
+        // put back with ungetwc, or handed off if it doesn't take them all
+        scn::wfile tmp{file.handle(), 64};
+        int i;
+        auto result = scn::scan_default(tmp, i);
+        CHECK(result);
+        CHECK(i == 123);
+    }
+
+    scn::wfile other{file.handle()};
+    std::wstring word;
+    auto result = scn::scan_default(other, word);
+    CHECK(result);
+    CHECK(word == L"word");
+    other.sync();
+
+    result = scn::scan_default(other, word);
+    CHECK(result);
+    CHECK(word == L"another");
+    other.set_handle(nullptr);
+}
+
+TEST_CASE("file handoff, discarding")
+{
+    scn::owning_wfile file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+    auto handle = file.handle();
+
+    // as if left over by a destroyed file range
+    scn::detail::put_file_handoff(handle, std::wstring{L"left "});
+
+    SUBCASE("discard_file_handoff")
+    {
+        scn::discard_file_handoff(handle);
+
+        scn::wfile other{handle};
+        int i;
+        auto result = scn::scan_default(other, i);
+        CHECK(result);
+        CHECK(i == 123);
+        other.set_handle(nullptr);
+    }
+
+    SUBCASE("close")
+    {
+        // nothing is left behind for a FILE* opened at the same address
+        file.close();
+        std::wstring left{};
+        scn::detail::take_file_handoff(handle, left);
+        CHECK(left.empty());
+    }
+}
+
+TEST_CASE("file handoff, closing and reopening")
+{
+    auto f = std::fopen("./test/file/testfile.txt", "r");
+    REQUIRE(f);
+
+    scn::wfile file{f, 64};
+    int i;
+    auto result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.sync();
+
+#ifdef __GLIBC__
+    // glibc takes back any number of characters with ungetwc:
+    // they're visible to <cstdio>
+    wchar_t buf[16] = {0};
+    CHECK(std::fwscanf(f, L"%15ls", buf) == 1);
+    CHECK(std::wstring{buf} == L"word");
+#endif
+
+    // the characters that couldn't be put back are kept in `file`,
+    // and dropped with it: nothing is left behind for the FILE*
+    file.set_handle(nullptr, false);
+    std::wstring left{};
+    scn::detail::take_file_handoff(f, left);
+    CHECK(left.empty());
+    std::fclose(f);
+
+    // a FILE* opened later, possibly at the same address,
+    // reads its own contents
+    auto g = std::fopen("./test/file/testfile.txt", "r");
+    REQUIRE(g);
+    file.set_handle(g);
+    result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.set_handle(nullptr, false);
+    std::fclose(g);
+}
+
+TEST_CASE("input discards characters on failure")
+{
+    REQUIRE(std::freopen("./test/file/testfile.txt", "r", stdin));
+
+    int i;
+    auto result = scn::input("{}", i);
+    CHECK(result);
+    CHECK(i == 123);
+
+    // "word" is not put back: retrying reads what comes after it
+    result = scn::input("{}", i);
+    CHECK(!result);
+    CHECK(result.error() == scn::error::invalid_scanned_value);
+
+    std::string word;
+    result = scn::input("{}", word);
+    CHECK(result);
+    CHECK(word == "another");
+}
+
+TEST_CASE("file with window, long input")
+{
+    auto f = make_int_file(10000);
+    REQUIRE(f);
+
+    scn::owning_file file{f};
+    file.set_block_size(64);
+    file.set_window_size(256);
+
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 10000);
+    CHECK(file.get_buffer(file.begin(), 1024).size() <= 256);
+}
+
+// Scanning a value must only cost work proportional to the characters
+// consumed, not to the size of the buffer read ahead: otherwise, this takes
+// minutes instead of milliseconds, and hits the test timeout
+template <typename File>
+static int scan_all_ints(File& file)
+{
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        if (i != expected) {
+            break;
+        }
+        ++expected;
+    }
+    return expected;
+}
+
+TEST_CASE("file throughput")
+{
+    const int n = 200000;
+    auto f = make_int_file(n);
+    REQUIRE(f);
+
+    SUBCASE("file")
+    {
+        scn::owning_file file{f};
+        file.set_block_size(64 * 1024);
+        file.set_window_size(64 * 1024);
+        CHECK(scan_all_ints(file) == n);
+    }
+    SUBCASE("prefetching file")
+    {
+        {
+            scn::prefetching_file file{f};
+            CHECK(scan_all_ints(file) == n);
+        }
+        std::fclose(f);
+    }
+#if SCN_POSIX
+    SUBCASE("fd file")
+    {
+        {
+            scn::fd_file file{::fileno(f)};
+            CHECK(scan_all_ints(file) == n);
+        }
+        std::fclose(f);
+    }
+    SUBCASE("uring file")
+    {
+        {
+            scn::uring_file file{::fileno(f)};
+            CHECK(scan_all_ints(file) == n);
+        }
+        std::fclose(f);
+    }
+#endif
+}
+
+#if SCN_POSIX
+TEST_CASE("fd file")
+{
+    int fd = ::open("./test/file/testfile.txt", O_RDONLY);
+    REQUIRE(fd != -1);
+    // small buffer: forces refills and growing
+    scn::fd_file file{fd, true, 4};
+    REQUIRE(file.valid());
+    CHECK(file.owns_handle());
+
+    SUBCASE("entire file")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        std::string word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == "word");
+
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == "another");
+
+        result = scn::scan_default(file, word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+
+    SUBCASE("error")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        result = scn::scan_default(file, i);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+        std::string word;
+        result = scn::scan_default(file, word);
+        CHECK(result);
+        CHECK(word == "word");
+    }
+
+    SUBCASE("getline")
+    {
+        std::string line;
+        auto result = scn::getline(file, line);
+        CHECK(result);
+        CHECK(line == "123");
+
+        result = scn::getline(file, line);
+        CHECK(result);
+        CHECK(line == "word another");
+    }
+
+    SUBCASE("syncing")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+        file.sync();
+
+        char buf[5] = {0};
+        CHECK(::read(file.handle(), buf, 4) == 4);
+        CHECK(std::string{buf} == "\nwor");
+    }
+}
+
+TEST_CASE("fd file pipe")
+{
+    int fd = make_int_pipe(1000);
+    REQUIRE(fd != -1);
+
+    scn::fd_file file{fd, true, 64};
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 1000);
+}
+#endif
+
+#if SCN_POSIX
+TEST_CASE("uring file")
+{
+    temp_int_file tmp{10000};
+    REQUIRE(!tmp.name().empty());
+    int fd = ::open(tmp.name().c_str(), O_RDONLY);
+    REQUIRE(fd != -1);
+
+    int i{}, expected{0};
+    {
+        // io_uring may not be available: works either way
+        scn::uring_file file{fd, false, 100, 3};
+        REQUIRE(file.valid());
+        while (scn::scan_default(file, i)) {
+            CHECK(i == expected);
+            ++expected;
+            if (expected == 5000) {
+                break;
+            }
+        }
+        CHECK(file.get_buffer(file.begin(), 1024).size() != 0);
+    }
+
+    // synced on destruction: the file position is right after "4999"
+    char buf[6] = {0};
+    CHECK(::read(fd, buf, 5) == 5);
+    CHECK(std::string{buf} == "\n5000");
+
+    {
+        scn::uring_file file{fd, true, 64, 4};
+        while (scn::scan_default(file, i)) {
+            ++expected;
+            CHECK(i == expected);
+        }
+        CHECK(expected == 9999);
+    }
+}
+
+#ifdef __linux__
+// Replace the io_uring instances of this process with /dev/null,
+// so that io_uring_enter fails on them. Returns the number replaced
+static int break_io_urings()
+{
+    const int null_fd = ::open("/dev/null", O_RDONLY);
+    if (null_fd == -1) {
+        return 0;
+    }
+    std::vector<int> fds{};
+    if (auto dir = ::opendir("/proc/self/fd")) {
+        while (auto entry = ::readdir(dir)) {
+            const auto path = std::string{"/proc/self/fd/"} + entry->d_name;
+            char target[64] = {0};
+            if (::readlink(path.c_str(), target, sizeof(target) - 1) > 0 &&
+                std::string{target} == "anon_inode:[io_uring]") {
+                fds.push_back(std::atoi(entry->d_name));
+            }
+        }
+        ::closedir(dir);
+    }
+    for (auto fd : fds) {
+        ::dup2(null_fd, fd);
+    }
+    ::close(null_fd);
+    return static_cast<int>(fds.size());
+}
+
+TEST_CASE("uring file, failing io_uring")
+{
+    temp_int_file tmp{10000};
+    REQUIRE(!tmp.name().empty());
+    int fd = ::open(tmp.name().c_str(), O_RDONLY);
+    REQUIRE(fd != -1);
+
+    scn::uring_file file{fd, true, 100, 3};
+    if (!file.uses_io_uring()) {
+        // io_uring not available: nothing to break
+        return;
+    }
+
+    int i{}, expected{0};
+    for (; expected < 1000; ++expected) {
+        REQUIRE(scn::scan_default(file, i));
+        CHECK(i == expected);
+    }
+    REQUIRE(break_io_urings() > 0);
+
+    SUBCASE("reading")
+    {
+    }
+    SUBCASE("syncing")
+    {
+        // the reads in flight are done, and the ring is started again
+        // on the next read
+        file.sync();
+    }
+
+    // read() is used from where io_uring left off
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 10000);
+    CHECK(!file.uses_io_uring());
+}
+#endif
+
+TEST_CASE("uring file pipe")
+{
+    int fd = make_int_pipe(1000);
+    REQUIRE(fd != -1);
+
+    // pipes can't be read from at an offset: read() is used
+    scn::uring_file file{fd, true, 64};
+    CHECK(!file.uses_io_uring());
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 1000);
+}
+#endif
+
+TEST_CASE("prefetching file")
+{
+    auto f = make_int_file(10000);
+    REQUIRE(f);
+
+    {
+        scn::prefetching_file file{f, 64, 4};
+        REQUIRE(file.valid());
+
+        int i{}, expected{0};
+        while (scn::scan_default(file, i)) {
+            CHECK(i == expected);
+            ++expected;
+            if (expected == 5000) {
+                break;
+            }
+        }
+        CHECK(expected == 5000);
+        CHECK(file.get_buffer(file.begin(), 1024).size() != 0);
+    }
+
+    // read ahead, but unconsumed characters are put back
+    int i{};
+    CHECK(std::fscanf(f, "%d", &i) == 1);
+    CHECK(i == 5000);
+
+    scn::file file{f};
+    int expected{5001};
+    auto result = scn::make_result(file);
+    while ((result = scn::scan_default(result.range(), i))) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 10000);
+    file.set_handle(nullptr);
+    std::fclose(f);
+}
+
+TEST_CASE("prefetching file sync")
+{
+    scn::owning_file f{"./test/file/testfile.txt", "r"};
+    REQUIRE(f.is_open());
+
+    scn::prefetching_file file{f.handle(), 4};
+    int i;
+    auto result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.sync();
+
+    char buf[16] = {0};
+    CHECK(std::fscanf(file.handle(), "%15s", buf) == 1);
+    CHECK(std::string{buf} == "word");
+
+    // reading is continued after sync
+    std::string word;
+    result = scn::scan_default(file, word);
+    CHECK(result);
+    CHECK(word == "another");
+    result = scn::scan_default(file, word);
+    CHECK(result.error() == scn::error::end_of_range);
+}
+
+TEST_CASE("prefetching wfile")
+{
+    auto f = std::tmpfile();
+    REQUIRE(f);
+    for (int i = 0; i < 1000; ++i) {
+        std::fwprintf(f, L"%d ", i);
+    }
+    std::rewind(f);
+
+    scn::prefetching_wfile file{f, 16};
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 1000);
+    file.sync();
+    std::fclose(f);
+}
+
+#if SCN_POSIX
+TEST_CASE("prefetching file pipe")
+{
+    int fd = make_int_pipe(1000);
+    REQUIRE(fd != -1);
+
+    auto f = ::fdopen(fd, "r");
+    REQUIRE(f);
+    int i{}, expected{0};
+    {
+        scn::prefetching_file file{f, 64};
+        while (expected < 500 && scn::scan_default(file, i)) {
+            CHECK(i == expected);
+            ++expected;
+        }
+    }
+
+    // pipes aren't seekable: the characters read ahead are put back with
+    // ungetc, or handed off
+    scn::file file{f};
+    auto result = scn::make_result(file);
+    while ((result = scn::scan_default(result.range(), i))) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 1000);
+    file.set_handle(nullptr);
+    std::fclose(f);
+}
+#endif
+
 TEST_CASE("mapped file")
 {
     scn::mapped_file file{"./test/file/testfile.txt"};
@@ -188,6 +1011,219 @@ TEST_CASE("mapped file")
     }
 }
 
+TEST_CASE("mapped file factory")
+{
+    SUBCASE("open")
+    {
+        auto file = scn::mapped_file::open("./test/file/testfile.txt");
+        REQUIRE(file);
+        CHECK(file.value().valid());
+        CHECK(file.value().size() == 16);
+
+        int i;
+        auto result = scn::scan_default(file.value().wrap(), i);
+        CHECK(result);
+        CHECK(i == 123);
+    }
+    SUBCASE("nonexistent")
+    {
+        auto file = scn::mapped_file::open("./test/file/nonexistent.txt");
+        CHECK(!file);
+        CHECK(file.error().code() == scn::error::source_error);
+#if SCN_POSIX
+        CHECK(errno == ENOENT);
+        CHECK(std::string{file.error().msg()} ==
+              "No such file or directory (ENOENT)");
+#endif
+    }
+    SUBCASE("sub-range")
+    {
+        // "word"
+        auto file = scn::mapped_file::open("./test/file/testfile.txt", 4, 4);
+        REQUIRE(file);
+        CHECK(file.value().size() == 4);
+
+        std::string word;
+        auto result = scn::scan_default(file.value().wrap(), word);
+        CHECK(result);
+        CHECK(word == "word");
+        CHECK(result.empty());
+    }
+    SUBCASE("offset past the end")
+    {
+        auto file =
+            scn::mapped_file::open("./test/file/testfile.txt", 100, 0);
+        CHECK(!file);
+        CHECK(file.error().code() == scn::error::invalid_argument);
+    }
+    SUBCASE("length past the end")
+    {
+        // "another", clamped to the end of the file
+        auto file =
+            scn::mapped_file::open("./test/file/testfile.txt", 9, 1 << 24);
+        REQUIRE(file);
+        CHECK(file.value().size() == 7);
+
+        std::string word;
+        auto result = scn::scan_default(file.value().wrap(), word);
+        CHECK(result);
+        CHECK(word == "another");
+        CHECK(result.empty());
+    }
+#if SCN_POSIX
+    SUBCASE("fd")
+    {
+        int fd = ::open("./test/file/testfile.txt", O_RDONLY);
+        REQUIRE(fd != -1);
+        // "another"
+        auto file = scn::mapped_file::map(fd, 9, 0);
+        ::close(fd);
+        REQUIRE(file);
+        CHECK(file.value().size() == 7);
+
+        std::string word;
+        auto result = scn::scan_default(file.value().wrap(), word);
+        CHECK(result);
+        CHECK(word == "another");
+    }
+    SUBCASE("bad fd")
+    {
+        auto file = scn::mapped_file::map(-1);
+        CHECK(!file);
+        CHECK(file.error().code() == scn::error::invalid_argument);
+    }
+#endif
+}
+
+TEST_CASE("mapped file with hints")
+{
+    scn::mapped_file file{"./test/file/testfile.txt",
+                          scn::map_hint::sequential | scn::map_hint::willneed |
+                              scn::map_hint::populate |
+                              scn::map_hint::huge_pages};
+    REQUIRE(file.valid());
+
+    int i;
+    auto result = scn::scan_default(file.wrap(), i);
+    CHECK(result);
+    CHECK(i == 123);
+
+    file.release(result.range().data());
+    file.release(file.end());
+
+    // still readable after release
+    std::string word;
+    result = scn::scan_default(result.range(), word);
+    CHECK(result);
+    CHECK(word == "word");
+    CHECK(file.buffer()[0] == '1');
+}
+
+TEST_CASE("mapped file release")
+{
+    temp_int_file tmp{10000};
+    REQUIRE(!tmp.name().empty());
+
+    scn::mapped_file file{tmp.name().c_str(), scn::map_hint::sequential};
+    REQUIRE(file.valid());
+
+    auto result = scn::make_result(file.wrap());
+    int i{}, expected{0};
+    while ((result = scn::scan_default(result.range(), i))) {
+        CHECK(i == expected);
+        ++expected;
+        file.release(result.range().data());
+    }
+    CHECK(expected == 10000);
+
+    // released pages are read again from the file
+    result = scn::scan_default(file.wrap(), i);
+    CHECK(result);
+    CHECK(i == 0);
+}
+
+TEST_CASE("windowed mapped file")
+{
+    scn::windowed_mapped_file file{"./test/file/testfile.txt", 1};
+    REQUIRE(file.valid());
+    CHECK(file.window_size() > 0);
+    CHECK(file.size() == 16);
+
+    auto result = scn::make_result(file);
+
+    int i;
+    result = scn::scan_default(result.range(), i);
+    CHECK(result);
+    CHECK(i == 123);
+
+    std::string word;
+    result = scn::scan_default(result.range(), word);
+    CHECK(result);
+    CHECK(word == "word");
+
+    result = scn::scan_default(result.range(), word);
+    CHECK(result);
+    CHECK(word == "another");
+
+    result = scn::scan_default(result.range(), word);
+    CHECK(!result);
+    CHECK(result.error().code() == scn::error::end_of_range);
+}
+
+TEST_CASE("windowed mapped file factory")
+{
+    SUBCASE("open")
+    {
+        auto file = scn::windowed_mapped_file::open("./test/file/testfile.txt");
+        REQUIRE(file);
+        CHECK(file.value().valid());
+        CHECK(file.value().size() == 16);
+
+        int i;
+        auto result = scn::scan_default(file.value(), i);
+        CHECK(result);
+        CHECK(i == 123);
+    }
+    SUBCASE("nonexistent")
+    {
+        auto file =
+            scn::windowed_mapped_file::open("./test/file/nonexistent.txt");
+        CHECK(!file);
+        CHECK(file.error().code() == scn::error::source_error);
+#if SCN_POSIX
+        CHECK(errno == ENOENT);
+#endif
+    }
+}
+
+TEST_CASE("windowed mapped file, multiple windows")
+{
+    temp_int_file tmp{10000};
+    REQUIRE(!tmp.name().empty());
+
+    // smallest possible window: values straddle the window boundaries
+    scn::windowed_mapped_file file{tmp.name().c_str(), 1};
+    REQUIRE(file.valid());
+
+    // begin() is the first character not yet consumed:
+    // scanning the file object again continues where the last scan
+    // left off
+    int i{}, expected{0};
+    while (scn::scan_default(file, i)) {
+        CHECK(i == expected);
+        ++expected;
+    }
+    CHECK(expected == 10000);
+
+    // only the final newline is left
+    std::string line;
+    auto line_result = scn::getline(file, line);
+    CHECK(line_result);
+    CHECK(line.empty());
+    line_result = scn::getline(file, line);
+    CHECK(line_result.error() == scn::error::end_of_range);
+}
+
 struct int_and_string {
     int i;
     std::string s;
@@ -263,6 +263,82 @@ TEST_CASE_TEMPLATE("non-contiguous", CharT, char, wchar_t)
     CHECK(f == doctest::Approx(3.14));
 }
 
+TEST_CASE("wide non-ASCII")
+{
+    double f{};
+    std::wstring unit{};
+    auto ret = scn::scan(L"21.5\u00b0C", L"{}{}", f, unit);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(21.5));
+    CHECK(unit == L"\u00b0C");
+
+    auto wret = scn::scan(L"1e\u00b2", L"{}", f);
+    CHECK(wret);
+    CHECK(f == doctest::Approx(1.0));
+    CHECK(wret.range().size() == 2);
+}
+
+TEST_CASE_TEMPLATE("hexfloat", T, float, double, long double)
+{
+    T f{};
+    std::string rest{};
+    auto ret = scn::scan("0x1.8p1 rest", "{} {}", f, rest);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(3.0));
+    CHECK(rest == "rest");
+
+    ret = scn::scan("-0x.4P-1", "{:a}", f);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(-0.125));
+
+    // ties to even
+    ret = scn::scan("0x1.0000000000000000000000000000008p0", "{}", f);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(1.0));
+
+    ret = scn::scan("0x1p-99999", "{}", f);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+    ret = scn::scan("0x1p99999", "{}", f);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    // no digits: just the "0"
+    ret = scn::scan("0xg", "{}{}", f, rest);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(0.0));
+    CHECK(rest == "xg");
+}
+
+TEST_CASE("long double")
+{
+    long double f{};
+    auto ret = scn::scan("123456789.125e-3", "{}", f);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(123456.789125L));
+
+    std::string rest{};
+    ret = scn::scan("-2.5e+3x", "{}{}", f, rest);
+    CHECK(ret);
+    CHECK(f == doctest::Approx(-2500.0L));
+    CHECK(rest == "x");
+
+    // beyond the exact fast path
+    ret = scn::scan("1.00000000000000000000000001e-300", "{}", f);
+    CHECK(ret);
+    CHECK(f > 0.0L);
+
+    // zero with an exponent outside the range of long double
+    ret = scn::scan("0e5000", "{}", f);
+    CHECK(ret);
+    CHECK(f == 0.0L);
+    CHECK(!std::signbit(f));
+    ret = scn::scan("-0e5000", "{}", f);
+    CHECK(ret);
+    CHECK(f == 0.0L);
+    CHECK(std::signbit(f));
+}
+
 TEST_CASE("float error")
 {
     double d{};
@@ -280,6 +356,27 @@ TEST_CASE("parse_float")
     CHECK(ret);
     CHECK(ret.value() == source.begin() + 4);
     CHECK(d == doctest::Approx(3.14));
+
+    // the input doesn't have to be NUL-terminated after the number
+    source = scn::string_view{"3.14159", 4};
+    ret = scn::parse_float(source, d);
+    CHECK(ret);
+    CHECK(ret.value() == source.end());
+    CHECK(d == doctest::Approx(3.14));
+
+    long double ld{};
+    source = scn::string_view{"2.5e10", 3};
+    ret = scn::parse_float(source, ld);
+    CHECK(ret);
+    CHECK(ret.value() == source.end());
+    CHECK(ld == doctest::Approx(2.5));
+
+    float f{};
+    auto wsource = scn::wstring_view{L"0.125e-3", 5};
+    auto wret = scn::parse_float(wsource, f);
+    CHECK(wret);
+    CHECK(wret.value() == wsource.end());
+    CHECK(f == doctest::Approx(0.125));
 }
 
 TEST_CASE("consistency")
@@ -527,6 +527,70 @@ TEST_CASE("integer thousands separator")
         CHECK(ret);
         CHECK(a == 100200);
     }
+
+    SUBCASE("multiple groups")
+    {
+        auto ret = scn::scan("-1,000,000 2,3,4", "{:'} {:'}", a, b);
+        CHECK(ret);
+        CHECK(a == -1000000);
+        CHECK(b == 234);
+
+        long long ll{};
+        ret = scn::scan("9,223,372,036,854,775,807", "{:'}", ll);
+        CHECK(ret);
+        CHECK(ll == std::numeric_limits<long long>::max());
+        ret = scn::scan("9,223,372,036,854,775,808", "{:'}", ll);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+        ret = scn::scan("0,000,000,000,000,000,000,001", "{:'d}", ll);
+        CHECK(ret);
+        CHECK(ll == 1);
+    }
+
+    SUBCASE("separator not between digits")
+    {
+        std::string rest{};
+        auto ret = scn::scan("1,000,", "{:'}{}", a, rest);
+        CHECK(ret);
+        CHECK(a == 1000);
+        CHECK(rest == ",");
+
+        ret = scn::scan("1,,000", "{:'}{}", a, rest);
+        CHECK(ret);
+        CHECK(a == 1);
+        CHECK(rest == ",,000");
+
+        ret = scn::scan(",100", "{:'}", a);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+
+    SUBCASE("custom separator")
+    {
+        auto ret = scn::scan("1_000_000 1'000", "{:'_} {:''}", a, b);
+        CHECK(ret);
+        CHECK(a == 1000000);
+        CHECK(b == 1000);
+
+        unsigned u{};
+        ret = scn::scan("dead_beef", "{:'_x}", u);
+        CHECK(ret);
+        CHECK(u == 0xdeadbeef);
+
+        // a letter after ' is a type flag, not a separator
+        ret = scn::scan("0x1,f", "{:'x}", u);
+        CHECK(ret);
+        CHECK(u == 0x1f);
+
+        auto wret = scn::scan(L"12_345", L"{:'_}", a);
+        CHECK(wret);
+        CHECK(a == 12345);
+
+        auto source = get_deque<char>("98_765_432");
+        auto dret = scn::scan(source, "{:'_}", a);
+        CHECK(dret);
+        CHECK(a == 98765432);
+    }
 }
 
 TEST_CASE("parse_integer")
@@ -583,6 +647,20 @@ TEST_CASE("parse_integer")
         CHECK(!ret);
         CHECK(ret.error() == scn::error::value_out_of_range);
     }
+    SUBCASE("bases")
+    {
+        scn::string_view source{"-1011z"};
+        const int bases[] = {2, 3, 4, 8, 10, 16, 36};
+        const long expected[] = {-11, -31, -69, -521, -1011, -4113, -1680983};
+        for (int b = 0; b < 7; ++b) {
+            long i{};
+            auto ret = scn::parse_integer<long>(source, i, bases[b]);
+            CHECK(ret);
+            CHECK(i == expected[b]);
+            CHECK(ret.value() ==
+                  source.begin() + (bases[b] == 36 ? 6 : 5));
+        }
+    }
 }
 
 template <typename T>
@@ -826,6 +904,294 @@ TEST_CASE_TEMPLATE_INSTANTIATE(integer_range_test,
                                wchar_intpair<unsigned long>,
                                wchar_intpair<unsigned long long>);
 
+TEST_CASE("long digit runs")
+{
+    SUBCASE("leading zeroes")
+    {
+        int i{};
+        auto ret = scn::scan("0000000000000000000000000042", "{:d}", i);
+        CHECK(ret);
+        CHECK(i == 42);
+        CHECK(ret.range().empty());
+    }
+    SUBCASE("non-digit inside a block")
+    {
+        long long i{};
+        auto ret = scn::scan_default("1234567x89", i);
+        CHECK(ret);
+        CHECK(i == 1234567);
+        CHECK(ret.range_as_string_view().size() == 3);
+
+        ret = scn::scan_default("123456789012345/6789", i);
+        CHECK(ret);
+        CHECK(i == 123456789012345);
+        CHECK(ret.range_as_string_view().size() == 5);
+    }
+    SUBCASE("every length")
+    {
+        unsigned long long expected = 0;
+        std::string source;
+        for (int n = 1; n <= 20; ++n) {
+            source.push_back(static_cast<char>('0' + (n % 10)));
+            expected = expected * 10 + static_cast<unsigned>(n % 10);
+
+            unsigned long long u{};
+            auto ret = scn::scan_default(source, u);
+            CHECK(ret);
+            CHECK(u == expected);
+
+            long long i{};
+            ret = scn::scan_default(source, i);
+            if (n < 20) {
+                CHECK(ret);
+                CHECK(i == static_cast<long long>(expected));
+            }
+            else {
+                CHECK(!ret);
+                CHECK(ret.error() == scn::error::value_out_of_range);
+            }
+        }
+    }
+    SUBCASE("overflow")
+    {
+        unsigned long long u{};
+        auto ret = scn::scan_default("18446744073709551616", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_default("99999999999999999999", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan("000000000018446744073709551615", "{:d}", u);
+        CHECK(ret);
+        CHECK(u == std::numeric_limits<unsigned long long>::max());
+
+        long long i{};
+        ret = scn::scan_default("-9223372036854775809", i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        unsigned int ui{};
+        ret = scn::scan_default("4294967296", ui);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_default("4294967295", ui);
+        CHECK(ret);
+        CHECK(ui == 4294967295u);
+    }
+    SUBCASE("wide characters")
+    {
+        const std::wstring digits = L"123456789012345678";
+        unsigned long long u{};
+        auto ret = scn::scan_default(
+            scn::wstring_view{digits.data(), digits.size()}, u);
+        CHECK(ret);
+        CHECK(u == 123456789012345678ull);
+
+        // code units that only share their low byte with a digit
+        // terminate the run
+        for (auto ch : {wchar_t{0x0135}, wchar_t{0xff10}, wchar_t{0x8039}}) {
+            unsigned long long expected = 0;
+            for (std::size_t pos = 1; pos < digits.size(); ++pos) {
+                expected = expected * 10 +
+                           static_cast<unsigned>(digits[pos - 1] - L'0');
+                auto source = digits;
+                source[pos] = ch;
+                ret = scn::scan_default(
+                    scn::wstring_view{source.data(), source.size()}, u);
+                CHECK(ret);
+                CHECK(u == expected);
+                CHECK(static_cast<std::size_t>(ret.range().size()) ==
+                      digits.size() - pos);
+            }
+        }
+
+        ret = scn::scan(L"0123456789abcdef ABCDEF", L"{:x}", u);
+        CHECK(ret);
+        CHECK(u == 0x0123456789abcdefull);
+        CHECK(ret.range().size() == 7);
+    }
+}
+
+TEST_CASE("integer digit count")
+{
+    // maximum-length runs only need the last digit checked
+    signed char sc{};
+    auto ret = scn::scan_default("-128", sc);
+    CHECK(ret);
+    CHECK(sc == -128);
+    ret = scn::scan_default("128", sc);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+    ret = scn::scan_default("200", sc);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    // runs longer than that overflow regardless of their value
+    int i{};
+    ret = scn::scan_default("10000000000", i);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+    ret = scn::scan_default("-10000000000", i);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    // leading zeroes don't count
+    ret = scn::scan("-00000000002147483648", "{:d}", i);
+    CHECK(ret);
+    CHECK(i == std::numeric_limits<int>::min());
+
+    unsigned short us{};
+    ret = scn::scan("0000065535 0000065536", "{:d}", us);
+    CHECK(ret);
+    CHECK(us == 65535);
+    ret = scn::scan(ret.range(), "{:d}", us);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+}
+
+TEST_CASE("power-of-two bases")
+{
+    unsigned long long u{};
+    auto ret = scn::scan("0123456789abcdef", "{:x}", u);
+    CHECK(ret);
+    CHECK(u == 0x0123456789abcdefull);
+
+    ret = scn::scan("FEDCBA9876543210", "{:x}", u);
+    CHECK(ret);
+    CHECK(u == 0xfedcba9876543210ull);
+
+    ret = scn::scan("deadbeg", "{:x}", u);
+    CHECK(ret);
+    CHECK(u == 0xdeadbe);
+    CHECK(ret.range_as_string_view().size() == 1);
+
+    ret = scn::scan("00000000000000000000ffffffffffffffff", "{:x}", u);
+    CHECK(ret);
+    CHECK(u == std::numeric_limits<unsigned long long>::max());
+
+    ret = scn::scan("10000000000000000", "{:x}", u);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    ret = scn::scan("1777777777777777777777", "{:o}", u);
+    CHECK(ret);
+    CHECK(u == std::numeric_limits<unsigned long long>::max());
+
+    ret = scn::scan("2000000000000000000000", "{:o}", u);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    auto bits = std::string(64, '1');
+    ret = scn::scan(scn::string_view{bits.data(), bits.size()}, "{:b}", u);
+    CHECK(ret);
+    CHECK(u == std::numeric_limits<unsigned long long>::max());
+
+    bits = "1" + std::string(64, '0');
+    ret = scn::scan(scn::string_view{bits.data(), bits.size()}, "{:b}", u);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    int i{};
+    ret = scn::scan("-80000000", "{:x}", i);
+    CHECK(ret);
+    CHECK(i == std::numeric_limits<int>::min());
+
+    ret = scn::scan("80000000", "{:x}", i);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+
+    ret = scn::scan("0x7fffFFFF", "{:i}", i);
+    CHECK(ret);
+    CHECK(i == std::numeric_limits<int>::max());
+
+    scn::string_view span_id{"4bf92f3577b34da6a3ce929d0e0e4736"};
+    unsigned long long hi{}, lo{};
+    auto spans = scn::scan(scn::string_view{span_id.data(), 16}, "{:x}", hi);
+    CHECK(spans);
+    spans = scn::scan(scn::string_view{span_id.data() + 16, 16}, "{:x}", lo);
+    CHECK(spans);
+    CHECK(hi == 0x4bf92f3577b34da6ull);
+    CHECK(lo == 0xa3ce929d0e0e4736ull);
+}
+
+#if SCN_HAS_INT128
+TEST_CASE("128-bit integers")
+{
+    using scn::detail::int128;
+    using scn::detail::uint128;
+
+    const auto int128_max = static_cast<int128>((uint128{1} << 127) - 1);
+    const auto int128_min = -int128_max - 1;
+    const auto uint128_max = ~uint128{0};
+
+    SUBCASE("limits")
+    {
+        int128 i{};
+        auto ret =
+            scn::scan("170141183460469231731687303715884105727", "{}", i);
+        CHECK(ret);
+        CHECK(i == int128_max);
+
+        ret = scn::scan("-170141183460469231731687303715884105728", "{}", i);
+        CHECK(ret);
+        CHECK(i == int128_min);
+
+        uint128 u{};
+        auto uret =
+            scn::scan("340282366920938463463374607431768211455", "{}", u);
+        CHECK(uret);
+        CHECK(u == uint128_max);
+    }
+    SUBCASE("overflow")
+    {
+        int128 i{};
+        auto ret =
+            scn::scan("170141183460469231731687303715884105728", "{}", i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        uint128 u{};
+        auto uret =
+            scn::scan("340282366920938463463374607431768211456", "{}", u);
+        CHECK(!uret);
+        CHECK(uret.error() == scn::error::value_out_of_range);
+
+        uret = scn::scan("-1", "{}", u);
+        CHECK(!uret);
+    }
+    SUBCASE("wider than 64 bits")
+    {
+        int128 i{};
+        auto ret = scn::scan("-12345678901234567890123", "{}", i);
+        CHECK(ret);
+        CHECK(i == -(int128{12345678901234567890ull} * 1000 + 123));
+
+        uint128 u{};
+        auto uret =
+            scn::scan("0x4bf92f3577b34da6a3ce929d0e0e4736", "{:i}", u);
+        CHECK(uret);
+        CHECK(u == ((uint128{0x4bf92f3577b34da6ull} << 64) |
+                    0xa3ce929d0e0e4736ull));
+
+        auto wret =
+            scn::scan(L"ffffffffffffffffffffffffffffffff", L"{:x}", u);
+        CHECK(wret);
+        CHECK(u == uint128_max);
+    }
+    SUBCASE("parse_integer")
+    {
+        int128 i{};
+        auto ret = scn::parse_integer<int128>(
+            scn::string_view{"-170141183460469231731687303715884105728"}, i);
+        CHECK(ret);
+        CHECK(i == int128_min);
+    }
+}
+#endif
+
 TEST_CASE("trailing")
 {
     int i{}, j{};
@@ -80,3 +80,59 @@ TEST_CASE("comma list until line break")
     CHECK(values.size() == cmp.size());
     CHECK(std::equal(values.begin(), values.end(), cmp.begin()));
 }
+
+TEST_CASE("scan_integers")
+{
+    std::vector<int> buf(8, 0);
+
+    auto ret = scn::scan_integers("1 -2\n+3\t 40000000", scn::make_span(buf));
+    CHECK(ret);
+    CHECK(ret.value() == 4);
+    CHECK(buf[0] == 1);
+    CHECK(buf[1] == -2);
+    CHECK(buf[2] == 3);
+    CHECK(buf[3] == 40000000);
+    CHECK(ret.range().empty());
+
+    ret = scn::scan_integers("1, 2 ,3,4 x", scn::make_span(buf), ',');
+    CHECK(ret);
+    CHECK(ret.value() == 4);
+    CHECK(buf[3] == 4);
+    CHECK(ret.range_as_string() == "x");
+
+    // stops when the buffer is full
+    ret = scn::scan_integers("1 2 3", scn::make_span(buf.data(), 2));
+    CHECK(ret);
+    CHECK(ret.value() == 2);
+    CHECK(ret.range_as_string() == "3");
+
+    ret = scn::scan_integers("5 99999999999 6", scn::make_span(buf));
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+    CHECK(buf[0] == 5);
+    CHECK(ret.range_as_string() == "99999999999 6");
+
+    // the count is kept on error
+    ret = scn::scan_integers("1 2 99999999999 4", scn::make_span(buf));
+    CHECK(ret.error() == scn::error::value_out_of_range);
+    CHECK(ret.value() == 2);
+    CHECK(buf[1] == 2);
+
+    ret = scn::scan_integers("  ", scn::make_span(buf));
+    CHECK(ret);
+    CHECK(ret.value() == 0);
+
+    std::vector<unsigned> ubuf(4, 0);
+    auto uret = scn::scan_integers("7 -8", scn::make_span(ubuf));
+    CHECK(uret);
+    CHECK(uret.value() == 1);
+    CHECK(uret.range_as_string() == "-8");
+
+    std::vector<long long> lbuf(4, 0);
+    auto wret = scn::scan_integers(L"9223372036854775807;-1",
+                                   scn::make_span(lbuf), L';');
+    CHECK(wret);
+    CHECK(wret.value() == 2);
+    CHECK(lbuf[0] == std::numeric_limits<long long>::max());
+    CHECK(lbuf[1] == -1);
+}
@@ -226,3 +226,165 @@ TEST_CASE("default localized scanning")
         CHECK(d == doctest::Approx(100.2));
     }
 }
+
+template <typename CharT>
+struct grouping_numpunct : std::numpunct<CharT> {
+    CharT do_thousands_sep() const override
+    {
+        return static_cast<CharT>('.');
+    }
+    CharT do_decimal_point() const override
+    {
+        return static_cast<CharT>(',');
+    }
+    std::string do_grouping() const override
+    {
+        return "\3";
+    }
+};
+
+TEST_CASE("localized integer grouping")
+{
+    const auto loc = std::locale(std::locale::classic(),
+                                 new grouping_numpunct<char>{});
+    const auto wloc = std::locale(std::locale::classic(),
+                                  new grouping_numpunct<wchar_t>{});
+
+    SUBCASE("grouping data")
+    {
+        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+        scn::detail::basic_custom_locale_ref<char> ref{&loc};
+        SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+        CHECK(ref.thousands_separator() == '.');
+        CHECK(ref.grouping().size() == 1);
+        CHECK(ref.grouping()[0] == 3);
+    }
+    SUBCASE("grouped")
+    {
+        int i{};
+        auto ret = scn::scan_localized(loc, "-1.234.567 8", "{:n}", i);
+        CHECK(ret);
+        CHECK(i == -1234567);
+        CHECK(ret.range_as_string_view().size() == 2);
+
+        long long ll{};
+        auto wret = scn::scan_localized(wloc, L"9.223.372.036.854.775.807",
+                                        L"{:n}", ll);
+        CHECK(wret);
+        CHECK(ll == std::numeric_limits<long long>::max());
+    }
+    SUBCASE("ungrouped")
+    {
+        int i{};
+        auto ret = scn::scan_localized(loc, "1234567", "{:n}", i);
+        CHECK(ret);
+        CHECK(i == 1234567);
+    }
+    SUBCASE("trailing separator")
+    {
+        int i{};
+        auto ret = scn::scan_localized(loc, "123.", "{:n}", i);
+        CHECK(ret);
+        CHECK(i == 123);
+        CHECK(ret.range_as_string_view().size() == 1);
+    }
+    SUBCASE("invalid grouping")
+    {
+        int i{};
+        auto ret = scn::scan_localized(loc, "12.34", "{:n}", i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+
+        ret = scn::scan_localized(loc, "1234.567", "{:n}", i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("out of range")
+    {
+        short s{};
+        auto ret = scn::scan_localized(loc, "32.768", "{:n}", s);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_localized(loc, "-32.768", "{:n}", s);
+        CHECK(ret);
+        CHECK(s == -32768);
+
+        unsigned u{};
+        ret = scn::scan_localized(loc, "-1", "{:n}", u);
+        CHECK(!ret);
+    }
+}
+
+TEST_CASE("localized float")
+{
+    const auto loc = std::locale(std::locale::classic(),
+                                 new grouping_numpunct<char>{});
+    const auto wloc = std::locale(std::locale::classic(),
+                                  new grouping_numpunct<wchar_t>{});
+
+    SUBCASE("decimal point")
+    {
+        double d{}, hex{};
+        auto ret =
+            scn::scan_localized(loc, "3,5 0x1,8p1", "{:L} {:La}", d, hex);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(3.5));
+        CHECK(hex == doctest::Approx(3.0));
+
+        ret = scn::scan_localized(loc, "1.5", "{:L}", d);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(1.0));
+        CHECK(ret.range_as_string_view().size() == 2);
+
+        long double ld{};
+        ret = scn::scan_localized(loc, "2,5e3 1,00000000000000000000001",
+                                  "{:L} {:L}", ld, d);
+        CHECK(ret);
+        CHECK(ld == doctest::Approx(2500.0L));
+        CHECK(d == doctest::Approx(1.0));
+    }
+    SUBCASE("grouped")
+    {
+        double d{};
+        auto ret = scn::scan_localized(loc, "-1.234.567,25", "{:n}", d);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(-1234567.25));
+
+        float f{};
+        auto wret = scn::scan_localized(wloc, L"1.000,5", L"{:n}", f);
+        CHECK(wret);
+        CHECK(f == doctest::Approx(1000.5f));
+
+        ret = scn::scan_localized(loc, "12.34,5", "{:n}", d);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("thsep flag")
+    {
+        double d{};
+        auto ret = scn::scan("1,23,4.5e1", "{:'}", d);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(12345.0));
+
+        ret = scn::scan_localized(loc, "1.234,5", "{:L'}", d);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(1234.5));
+    }
+    SUBCASE("custom thsep")
+    {
+        double d{}, e{};
+        auto ret = scn::scan("1_234.5 1'000'000", "{:'_} {:''}", d, e);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(1234.5));
+        CHECK(e == doctest::Approx(1000000.0));
+
+        ret = scn::scan_localized(loc, "1_234,5", "{:L'_}", d);
+        CHECK(ret);
+        CHECK(d == doctest::Approx(1234.5));
+
+        ret = scn::scan("1.5", "{:'.}", d);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_format_string);
+    }
+}
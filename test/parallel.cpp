@@ -0,0 +1,185 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+#include <scn/scan/parallel.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+static std::string make_lines(int n)
+{
+    std::string str;
+    for (int i = 0; i < n; ++i) {
+        str += std::to_string(i);
+        str += ',';
+        str += std::to_string(i * 2);
+        str += '\n';
+    }
+    return str;
+}
+
+TEST_CASE("split shards")
+{
+    std::string source = make_lines(1000);
+    auto shards = scn::detail::split_shards(
+        scn::string_view{source.data(), source.size()}, '\n', 8, 16);
+    CHECK(shards.size() == 8);
+
+    std::string joined;
+    for (auto s : shards) {
+        CHECK(!s.empty());
+        CHECK(s.back() == '\n');
+        joined.append(s.data(), s.size());
+    }
+    CHECK(joined == source);
+
+    SUBCASE("small input")
+    {
+        shards = scn::detail::split_shards(
+            scn::string_view{source.data(), source.size()}, '\n', 8,
+            source.size());
+        CHECK(shards.size() == 1);
+    }
+    SUBCASE("no delimiter")
+    {
+        std::string str(1000, 'a');
+        shards = scn::detail::split_shards(
+            scn::string_view{str.data(), str.size()}, '\n', 8, 16);
+        CHECK(shards.size() == 1);
+        CHECK(shards[0].size() == str.size());
+    }
+    SUBCASE("empty")
+    {
+        shards = scn::detail::split_shards(scn::string_view{}, '\n', 8, 16);
+        CHECK(shards.empty());
+    }
+}
+
+TEST_CASE("scan_parallel")
+{
+    const int n = 10000;
+    std::string source = make_lines(n);
+
+    // No assertions in the shard callbacks, they run concurrently
+    std::atomic<int> mismatches{0};
+    auto sums = scn::scan_parallel(
+        source,
+        [&](scn::string_view shard) {
+            long long sum = 0;
+            auto result = scn::make_result(shard);
+            int a, b;
+            while ((result = scn::scan(result.range(), "{},{}", a, b))) {
+                if (b != a * 2) {
+                    ++mismatches;
+                }
+                sum += b;
+            }
+            if (result.error() != scn::error::end_of_range) {
+                ++mismatches;
+            }
+            return sum;
+        },
+        scn::scan_parallel_options<char>{'\n', 4, 1024});
+    CHECK(mismatches == 0);
+    CHECK(sums.size() > 1);
+    CHECK(std::accumulate(sums.begin(), sums.end(), 0LL) ==
+          static_cast<long long>(n - 1) * n);
+
+    SUBCASE("in order")
+    {
+        auto firsts = scn::scan_parallel(
+            source,
+            [](scn::string_view shard) {
+                int i{-1};
+                auto ret = scn::scan_default(shard, i);
+                SCN_UNUSED(ret);
+                return i;
+            },
+            scn::scan_parallel_options<char>{'\n', 4, 1024});
+        CHECK(std::is_sorted(firsts.begin(), firsts.end()));
+        CHECK(firsts.front() == 0);
+    }
+    SUBCASE("empty")
+    {
+        auto ret = scn::scan_parallel(std::string{},
+                                      [](scn::string_view) { return 0; });
+        CHECK(ret.empty());
+    }
+}
+
+TEST_CASE("scan_list_parallel")
+{
+    std::string source;
+    for (int i = 0; i < 10000; ++i) {
+        source += std::to_string(i);
+        source += (i % 10 == 9) ? '\n' : ' ';
+    }
+
+    std::vector<int> values;
+    auto e = scn::scan_list_parallel(
+        source, values, scn::scan_parallel_options<char>{'\n', 4, 1024});
+    CHECK(e);
+    REQUIRE(values.size() == 10000);
+    for (int i = 0; i < 10000; ++i) {
+        CHECK(values[static_cast<size_t>(i)] == i);
+    }
+
+    SUBCASE("separator")
+    {
+        values.clear();
+        e = scn::scan_list_parallel(
+            "1,2,3,4,5,6", values, scn::scan_parallel_options<char>{',', 4, 2});
+        CHECK(e);
+        CHECK(values == std::vector<int>{1, 2, 3, 4, 5, 6});
+    }
+    SUBCASE("error")
+    {
+        values.clear();
+        e = scn::scan_list_parallel(
+            "1\n2\nfoo\n4\n5\n", values,
+            scn::scan_parallel_options<char>{'\n', 4, 2});
+        CHECK(e == scn::error::invalid_scanned_value);
+        CHECK(values == std::vector<int>{1, 2});
+    }
+}
+
+TEST_CASE("scan_parallel mapped file")
+{
+    {
+        std::ofstream os{"./test/parallel.txt"};
+        for (int i = 0; i < 5000; ++i) {
+            os << i << '\n';
+        }
+    }
+    {
+        scn::mapped_file file{"./test/parallel.txt"};
+        REQUIRE(file.valid());
+
+        std::vector<int> values;
+        auto e = scn::scan_list_parallel(
+            file, values, scn::scan_parallel_options<char>{'\n', 0, 4096});
+        CHECK(e);
+        CHECK(values.size() == 5000);
+        CHECK(values[4999] == 4999);
+    }
+    std::remove("./test/parallel.txt");
+}